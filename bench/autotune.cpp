@@ -0,0 +1,313 @@
+#include <iostream>
+#include "../include/symspell.h"
+#include "benchutils.h"
+
+using namespace std;
+
+// Parameter sweep for the SymSpell constructor: builds one index per combination of prefix length,
+// dictionary edit distance and count threshold, and measures index bytes, build time, lookup latency
+// percentiles and recall against an exhaustive scan of the whole dictionary. Prints every run and,
+// among those reaching --min-recall, the Pareto optimal ones (no other run is at least as small, fast
+// to build, fast to query and accurate, and strictly better in one of these) as JSON.
+
+namespace {
+    struct Options
+    {
+        string dictionary;
+        int termIndex = 1;
+        int countIndex = 0;
+        string queriesFile;
+        size_t queries = 2000;
+        vector<int> typos = { 1, 2 };
+        uint64_t seed = 42;
+        int maxEditDistance = defaultMaxEditDistance;
+        symspell::Verbosity verbosity = symspell::Verbosity::Top;
+        vector<int> prefixLengths = { 5, 6, 7, 8, 10 };
+        vector<int> dictionaryEditDistances = { 1, 2, 3 };
+        vector<int> countThresholds = { 1 };
+        double minRecall = 0;
+    };
+
+    struct Run
+    {
+        int prefixLength;
+        int dictionaryEditDistance;
+        int countThreshold;
+        double buildSeconds;
+        size_t indexBytes;
+        size_t entries;
+        double meanNs;
+        double p50Ns;
+        double p99Ns;
+        double recall;
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> [--queries-file PATH | --queries N --typos E,E,...] [--seed S]"
+             << " [--max-edit-distance D] [--verbosity top|closest|all] [--prefix-lengths P,P,...]"
+             << " [--dictionary-edit-distances D,D,...] [--count-thresholds T,T,...] [--min-recall R] [--term-index I] [--count-index I]" << endl;
+    }
+
+    bool ParseList(const char* text, vector<int>& values)
+    {
+        values.clear();
+        std::stringstream ss(text);
+        string value;
+        while (std::getline(ss, value, ','))
+            if (!value.empty()) values.push_back(atoi(value.c_str()));
+        return !values.empty();
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--queries-file" && hasValue) options.queriesFile = argv[++i];
+            else if (arg == "--queries" && hasValue) options.queries = atol(argv[++i]);
+            else if (arg == "--typos" && hasValue) { if (!ParseList(argv[++i], options.typos)) return false; }
+            else if (arg == "--seed" && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--prefix-lengths" && hasValue) { if (!ParseList(argv[++i], options.prefixLengths)) return false; }
+            else if (arg == "--dictionary-edit-distances" && hasValue) { if (!ParseList(argv[++i], options.dictionaryEditDistances)) return false; }
+            else if (arg == "--count-thresholds" && hasValue) { if (!ParseList(argv[++i], options.countThresholds)) return false; }
+            else if (arg == "--min-recall" && hasValue) options.minRecall = atof(argv[++i]);
+            else if (arg == "--term-index" && hasValue) options.termIndex = atoi(argv[++i]);
+            else if (arg == "--count-index" && hasValue) options.countIndex = atoi(argv[++i]);
+            else if (arg == "--verbosity" && hasValue)
+            {
+                string value = argv[++i];
+                if (value == "top") options.verbosity = symspell::Verbosity::Top;
+                else if (value == "closest") options.verbosity = symspell::Verbosity::Closest;
+                else if (value == "all") options.verbosity = symspell::Verbosity::All;
+                else return false;
+            }
+            else if (arg[0] != '-' && options.dictionary.empty()) options.dictionary = arg;
+            else return false;
+        }
+        return !options.dictionary.empty() && options.maxEditDistance >= 0;
+    }
+
+    const char* VerbosityName(symspell::Verbosity verbosity)
+    {
+        switch (verbosity)
+        {
+        case symspell::Verbosity::Top: return "top";
+        case symspell::Verbosity::Closest: return "closest";
+        default: return "all";
+        }
+    }
+
+    /// <summary>Words and summed counts of the dictionary, read like LoadDictionary does.</summary>
+    vector<pair<string, long>> ReadWords(const Options& options)
+    {
+        unordered_map<string, long> counts;
+        ifstream stream(options.dictionary);
+        string line;
+        while (std::getline(stream, line))
+        {
+            if (line.find(' ') != string::npos) continue;
+            vector<string> parts;
+            std::stringstream ss(line);
+            string token;
+            while (std::getline(ss, token, '\t')) parts.push_back(token);
+            if (parts.size() >= 2 && (size_t)max(options.termIndex, options.countIndex) < parts.size())
+                counts[parts[options.termIndex]] += atol(parts[options.countIndex].c_str());
+        }
+        return vector<pair<string, long>>(counts.begin(), counts.end());
+    }
+
+    /// <summary>The answer a complete search would give: for Top the (distance, count) of the best word,
+    /// for Closest and All the words it returns.</summary>
+    struct Expected
+    {
+        int distance = -1;
+        long count = 0;
+        vector<string> words;
+    };
+
+    Expected Exhaustive(const vector<pair<string, long>>& words, const string& query, int maxEditDistance, symspell::Verbosity verbosity)
+    {
+        static symspell::EditDistance distance(symspell::EditDistance::DistanceAlgorithm::DamerauOSA);
+        Expected expected;
+        vector<pair<int, const pair<string, long>*>> matches;
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            if (abs((int)words[i].first.size() - (int)query.size()) > maxEditDistance) continue;
+            int d = distance.Compare(query, words[i].first, maxEditDistance);
+            if (d >= 0) matches.push_back(make_pair(d, &words[i]));
+        }
+        if (matches.empty()) return expected;
+        int best = matches[0].first;
+        for (size_t i = 1; i < matches.size(); ++i) best = min(best, matches[i].first);
+        expected.distance = best;
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            if (matches[i].first == best) expected.count = max(expected.count, matches[i].second->second);
+            if (verbosity == symspell::Verbosity::All || matches[i].first == best) expected.words.push_back(matches[i].second->first);
+        }
+        std::sort(expected.words.begin(), expected.words.end());
+        return expected;
+    }
+
+    /// <summary>Share of the expected answer found: 0 or 1 for Top, the fraction of expected words otherwise.</summary>
+    double Recall(const Expected& expected, vector<std::unique_ptr<symspell::SuggestItem>>& items, symspell::Verbosity verbosity)
+    {
+        if (verbosity == symspell::Verbosity::Top)
+            return !items.empty() && items[0]->distance == expected.distance && items[0]->count == expected.count ? 1 : 0;
+        vector<string> found;
+        for (size_t i = 0; i < items.size(); ++i) found.push_back(items[i]->term);
+        std::sort(found.begin(), found.end());
+        size_t hits = 0;
+        for (size_t i = 0; i < expected.words.size(); ++i)
+            if (std::binary_search(found.begin(), found.end(), expected.words[i])) ++hits;
+        return (double)hits / expected.words.size();
+    }
+
+    bool Dominates(const Run& a, const Run& b)
+    {
+        bool noWorse = a.indexBytes <= b.indexBytes && a.buildSeconds <= b.buildSeconds && a.p50Ns <= b.p50Ns && a.p99Ns <= b.p99Ns && a.recall >= b.recall;
+        bool better = a.indexBytes < b.indexBytes || a.buildSeconds < b.buildSeconds || a.p50Ns < b.p50Ns || a.p99Ns < b.p99Ns || a.recall > b.recall;
+        return noWorse && better;
+    }
+
+    void WriteRun(symspell::bench::JsonWriter& json, const Run& run)
+    {
+        json.BeginObject()
+            .Value("prefix_length", run.prefixLength)
+            .Value("dictionary_edit_distance", run.dictionaryEditDistance)
+            .Value("count_threshold", run.countThreshold)
+            .Value("build_seconds", run.buildSeconds)
+            .Value("index_bytes", run.indexBytes)
+            .Value("entries", run.entries)
+            .Value("mean_ns", run.meanNs)
+            .Value("p50_ns", run.p50Ns)
+            .Value("p99_ns", run.p99Ns)
+            .Value("recall", run.recall)
+            .EndObject();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    vector<pair<string, long>> words = ReadWords(options);
+    if (words.empty())
+    {
+        cerr << "no words in " << options.dictionary << endl;
+        return 1;
+    }
+
+    vector<string> queries;
+    if (!options.queriesFile.empty())
+    {
+        ifstream stream(options.queriesFile);
+        string line;
+        while (std::getline(stream, line))
+            if (!line.empty()) queries.push_back(line);
+    }
+    else
+    {
+        vector<string> terms = symspell::bench::ReadTerms(options.dictionary, options.termIndex);
+        for (size_t t = 0; t < options.typos.size(); ++t)
+        {
+            vector<string> generated = symspell::bench::GenerateQueries(terms, options.queries / options.typos.size(), options.typos[t], options.seed + t);
+            queries.insert(queries.end(), generated.begin(), generated.end());
+        }
+    }
+
+    // queries without any word within maxEditDistance have nothing to recall and are only timed
+    vector<Expected> expected(queries.size());
+    size_t answerable = 0;
+    for (size_t q = 0; q < queries.size(); ++q)
+    {
+        expected[q] = Exhaustive(words, queries[q], options.maxEditDistance, options.verbosity);
+        if (expected[q].distance >= 0) ++answerable;
+    }
+
+    vector<Run> runs;
+    vector<std::unique_ptr<symspell::SuggestItem>> items;
+    for (size_t d = 0; d < options.dictionaryEditDistances.size(); ++d)
+    {
+        for (size_t p = 0; p < options.prefixLengths.size(); ++p)
+        {
+            for (size_t c = 0; c < options.countThresholds.size(); ++c)
+            {
+                Run run;
+                run.dictionaryEditDistance = options.dictionaryEditDistances[d];
+                run.prefixLength = options.prefixLengths[p];
+                run.countThreshold = options.countThresholds[c];
+                // the prefix has to be longer than the edit distance
+                if (run.dictionaryEditDistance < 0 || run.prefixLength <= run.dictionaryEditDistance) continue;
+
+                symspell::bench::Timer build;
+                symspell::SymSpell symSpell(defaultInitialCapacity, run.dictionaryEditDistance, run.prefixLength, run.countThreshold);
+                for (size_t w = 0; w < words.size(); ++w) symSpell.CreateDictionaryEntry(words[w].first, words[w].second);
+                symSpell.FinishLoading();
+                run.buildSeconds = build.Seconds();
+                run.indexBytes = symSpell.MemoryUsage().TotalBytes();
+                run.entries = symSpell.EntryCount();
+
+                int lookupEditDistance = min(options.maxEditDistance, run.dictionaryEditDistance);
+                double recall = 0;
+                for (size_t q = 0; q < queries.size(); ++q)
+                {
+                    if (expected[q].distance < 0) continue;
+                    symSpell.Lookup(queries[q], options.verbosity, lookupEditDistance, items);
+                    recall += Recall(expected[q], items, options.verbosity);
+                }
+                run.recall = answerable == 0 ? 1 : recall / answerable;
+
+                vector<double> latencies;
+                latencies.reserve(queries.size());
+                symspell::bench::Timer total;
+                for (size_t q = 0; q < queries.size(); ++q)
+                {
+                    symspell::bench::Timer one;
+                    symSpell.Lookup(queries[q], options.verbosity, lookupEditDistance, items);
+                    latencies.push_back(one.Nanoseconds());
+                }
+                run.meanNs = total.Nanoseconds() / max((size_t)1, queries.size());
+                std::sort(latencies.begin(), latencies.end());
+                run.p50Ns = symspell::bench::Percentile(latencies, 0.50);
+                run.p99Ns = symspell::bench::Percentile(latencies, 0.99);
+                runs.push_back(run);
+                cerr << "prefix " << run.prefixLength << " distance " << run.dictionaryEditDistance << " threshold " << run.countThreshold
+                     << ": recall " << run.recall << ", p50 " << run.p50Ns << " ns" << endl;
+            }
+        }
+    }
+
+    vector<Run> pareto;
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        if (runs[i].recall < options.minRecall) continue;
+        bool dominated = false;
+        for (size_t j = 0; j < runs.size() && !dominated; ++j) dominated = j != i && runs[j].recall >= options.minRecall && Dominates(runs[j], runs[i]);
+        if (!dominated) pareto.push_back(runs[i]);
+    }
+    std::sort(pareto.begin(), pareto.end(), [](const Run& l, const Run& r) { return l.indexBytes < r.indexBytes; });
+
+    symspell::bench::JsonWriter json;
+    json.BeginObject();
+    json.Value("dictionary", options.dictionary).Value("words", words.size()).Value("queries", queries.size())
+        .Value("answerable_queries", answerable).Value("max_edit_distance", options.maxEditDistance)
+        .Value("verbosity", VerbosityName(options.verbosity)).Value("min_recall", options.minRecall);
+    json.BeginArray("runs");
+    for (size_t i = 0; i < runs.size(); ++i) WriteRun(json, runs[i]);
+    json.EndArray();
+    json.BeginArray("pareto");
+    for (size_t i = 0; i < pareto.size(); ++i) WriteRun(json, pareto[i]);
+    json.EndArray();
+    json.EndObject();
+    cout << json.str() << endl;
+    return 0;
+}
@@ -0,0 +1,256 @@
+#ifndef SYMSPELL_BENCHUTILS_H
+#define SYMSPELL_BENCHUTILS_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <unistd.h>
+#include <sys/resource.h>
+
+namespace symspell {
+namespace bench {
+
+    class Timer
+    {
+    public:
+        Timer() : start(std::chrono::steady_clock::now()) { }
+        void Reset() { start = std::chrono::steady_clock::now(); }
+        double Seconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+        double Nanoseconds() const { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count(); }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /// <summary>Current resident set size in bytes, read from /proc/self/statm.</summary>
+    inline size_t CurrentRss()
+    {
+        std::ifstream statm("/proc/self/statm");
+        size_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * (size_t)sysconf(_SC_PAGESIZE);
+    }
+
+    /// <summary>Peak resident set size of the process in bytes.</summary>
+    inline size_t PeakRss()
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return (size_t)usage.ru_maxrss * 1024;
+    }
+
+    /// <summary>Value at quantile q (0..1) of an ascending sorted sample.</summary>
+    inline double Percentile(const std::vector<double>& sorted, double q)
+    {
+        if (sorted.empty()) return 0;
+        size_t index = (size_t)(q * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    /// <summary>Log-linear latency histogram in the style of HdrHistogram, with fixed memory and exact merging.</summary>
+    /// Values below 2^(subBucketBits + 1) get a counter each; above that, every power of two is split into
+    /// 2^subBucketBits counters, so a reported value is at most 2^-subBucketBits (0.8% at 7 bits) above the
+    /// recorded one.
+    class LatencyHistogram
+    {
+    public:
+        explicit LatencyHistogram(int subBucketBits = 7)
+            : subBucketBits(subBucketBits), counts((size_t)(65 - subBucketBits) << subBucketBits, 0) { }
+
+        void Record(uint64_t value)
+        {
+            ++counts[Index(value)];
+            ++total;
+            sum += (double)value;
+            maxValue = std::max(maxValue, value);
+        }
+
+        void Merge(const LatencyHistogram& other)
+        {
+            for (size_t i = 0; i < counts.size() && i < other.counts.size(); ++i) counts[i] += other.counts[i];
+            total += other.total;
+            sum += other.sum;
+            maxValue = std::max(maxValue, other.maxValue);
+        }
+
+        uint64_t Count() const { return total; }
+        uint64_t Max() const { return maxValue; }
+        double Mean() const { return total == 0 ? 0 : sum / total; }
+
+        /// <summary>Highest value equivalent to the value at quantile q (0..1).</summary>
+        uint64_t Percentile(double q) const
+        {
+            if (total == 0) return 0;
+            uint64_t rank = std::max((uint64_t)1, (uint64_t)std::ceil(q * total));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < counts.size(); ++i)
+            {
+                seen += counts[i];
+                if (seen >= rank) return std::min(UpperBound(i), maxValue);
+            }
+            return maxValue;
+        }
+
+    private:
+        size_t Index(uint64_t value) const
+        {
+            uint64_t subBuckets = 1ULL << subBucketBits;
+            if (value < 2 * subBuckets) return (size_t)value;
+            int shift = 63 - __builtin_clzll(value) - subBucketBits;
+            return (size_t)(shift * subBuckets + (value >> shift));
+        }
+
+        uint64_t UpperBound(size_t index) const
+        {
+            uint64_t subBuckets = 1ULL << subBucketBits;
+            if (index < 2 * subBuckets) return index;
+            int shift = (int)(index >> subBucketBits) - 1;
+            uint64_t bucket = index - shift * subBuckets;
+            return ((bucket + 1) << shift) - 1;
+        }
+
+        int subBucketBits;
+        std::vector<uint64_t> counts;
+        uint64_t total = 0;
+        double sum = 0;
+        uint64_t maxValue = 0;
+    };
+
+    /// <summary>Seeded generator of misspellings: insert, delete, substitute and transpose typos.</summary>
+    /// The same seed, dictionary and parameters always produce the same query list.
+    class TypoGenerator
+    {
+    public:
+        enum Operation { Insert, Delete, Substitute, Transpose };
+
+        TypoGenerator(uint64_t seed, const std::string& alphabet = "abcdefghijklmnopqrstuvwxyz")
+            : random(seed), alphabet(alphabet) { }
+
+        /// <summary>Applies the given number of random edits to word.</summary>
+        std::string Generate(const std::string& word, int edits)
+        {
+            std::string typo = word;
+            for (int e = 0; e < edits; ++e) Apply(typo, (Operation)Next(4));
+            return typo;
+        }
+
+        void Apply(std::string& word, Operation operation)
+        {
+            size_t len = word.size();
+            if (len < 2 && (operation == Delete || operation == Transpose)) operation = Insert;
+            switch (operation)
+            {
+            case Insert: word.insert(word.begin() + Next(len + 1), RandomChar()); break;
+            case Delete: word.erase(Next(len), 1); break;
+            case Substitute:
+            {
+                if (len == 0) { word += RandomChar(); break; }
+                size_t i = Next(len);
+                char c = RandomChar();
+                while (c == word[i] && alphabet.size() > 1) c = RandomChar();
+                word[i] = c;
+                break;
+            }
+            case Transpose:
+            {
+                size_t i = Next(len - 1);
+                std::swap(word[i], word[i + 1]);
+                break;
+            }
+            }
+        }
+
+        /// <summary>Uniform index in [0, bound).</summary>
+        size_t Next(size_t bound) { return bound == 0 ? 0 : (size_t)(random() % bound); }
+
+    private:
+        char RandomChar() { return alphabet[Next(alphabet.size())]; }
+
+        std::mt19937_64 random;
+        std::string alphabet;
+    };
+
+    /// <summary>Picks count dictionary terms (uniformly, seeded) and misspells each with the given number of edits.</summary>
+    inline std::vector<std::string> GenerateQueries(const std::vector<std::string>& terms, size_t count, int edits, uint64_t seed)
+    {
+        TypoGenerator generator(seed);
+        std::vector<std::string> queries;
+        queries.reserve(count);
+        for (size_t i = 0; i < count && !terms.empty(); ++i)
+            queries.push_back(generator.Generate(terms[generator.Next(terms.size())], edits));
+        return queries;
+    }
+
+    /// <summary>Minimal streaming JSON writer, enough for flat benchmark reports.</summary>
+    class JsonWriter
+    {
+    public:
+        JsonWriter& BeginObject(const char* key = nullptr) { Key(key); out << "{"; first = true; return *this; }
+        JsonWriter& EndObject() { out << "}"; first = false; return *this; }
+        JsonWriter& BeginArray(const char* key = nullptr) { Key(key); out << "["; first = true; return *this; }
+        JsonWriter& EndArray() { out << "]"; first = false; return *this; }
+
+        JsonWriter& Value(const char* key, const std::string& value) { Key(key); Quote(value); return *this; }
+        JsonWriter& Value(const char* key, const char* value) { return Value(key, std::string(value)); }
+        JsonWriter& Value(const char* key, double value) { Key(key); out << value; return *this; }
+        JsonWriter& Value(const char* key, size_t value) { Key(key); out << value; return *this; }
+        JsonWriter& Value(const char* key, int value) { Key(key); out << value; return *this; }
+
+        std::string str() const { return out.str(); }
+
+    private:
+        void Key(const char* key)
+        {
+            if (!first) out << ",";
+            first = false;
+            if (key != nullptr) { Quote(key); out << ":"; }
+        }
+
+        void Quote(const std::string& value)
+        {
+            out << '"';
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                char c = value[i];
+                if (c == '"' || c == '\\') out << '\\' << c;
+                else if ((unsigned char)c < 0x20) { char buffer[8]; snprintf(buffer, sizeof(buffer), "\\u%04x", c); out << buffer; }
+                else out << c;
+            }
+            out << '"';
+        }
+
+        std::ostringstream out;
+        bool first = true;
+    };
+
+    /// <summary>Reads the terms of a tab separated frequency dictionary, in the same layout as LoadDictionary.</summary>
+    inline std::vector<std::string> ReadTerms(const std::string& corpus, int termIndex)
+    {
+        std::vector<std::string> terms;
+        std::ifstream stream(corpus);
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            if (line.find(' ') != std::string::npos) continue;
+            std::stringstream ss(line);
+            std::string token;
+            for (int i = 0; std::getline(ss, token, '\t'); ++i)
+            {
+                if (i == termIndex)
+                {
+                    terms.push_back(token);
+                    break;
+                }
+            }
+        }
+        return terms;
+    }
+}
+}
+
+#endif // SYMSPELL_BENCHUTILS_H
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <sys/wait.h>
+#include "../include/symspell.h"
+#include "benchutils.h"
+
+using namespace std;
+
+// Compares the hash container backends of BasicSymSpell on one dictionary.
+// Every backend runs in its own child process so the resident set size is not
+// polluted by memory that a previous backend returned to malloc but not to the OS.
+
+template <typename MapPolicy>
+void RunBackend(const string& corpus, const vector<string>& queries)
+{
+    size_t rssBefore = symspell::bench::CurrentRss();
+    symspell::bench::Timer timer;
+    symspell::MonotonicArena arena;
+    symspell::BasicSymSpell<MapPolicy> symSpell(defaultInitialCapacity, defaultMaxEditDistance, defaultPrefixLength, defaultCountThreshold, defaultCompactLevel,
+        MapPolicy::usesArena ? &arena : nullptr);
+    symSpell.LoadDictionary(corpus, 1, 0);
+    double loadSeconds = timer.Seconds();
+    size_t rssAfter = symspell::bench::CurrentRss();
+
+    vector<std::unique_ptr<symspell::SuggestItem>> items;
+    double latency[3];
+    symspell::Verbosity verbosities[3] = { symspell::Verbosity::Top, symspell::Verbosity::Closest, symspell::Verbosity::All };
+    for (int v = 0; v < 3; ++v)
+    {
+        timer.Reset();
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            string query = queries[i];
+            symSpell.Lookup(query, verbosities[v], items);
+        }
+        latency[v] = timer.Nanoseconds() / 1000.0 / queries.size();
+    }
+
+    printf("%-14s %10zu %10zu %10.1f %10.1f %10.2f %10.2f %10.2f %10.2f\n", MapPolicy::Name(), symSpell.WordCount(), symSpell.EntryCount(),
+        (rssAfter - rssBefore) / (1024.0 * 1024.0), symSpell.MemoryUsage().TotalBytes() / (1024.0 * 1024.0), loadSeconds, latency[0], latency[1], latency[2]);
+    fflush(stdout);
+}
+
+template <typename MapPolicy>
+void ForkBackend(const string& corpus, const vector<string>& queries)
+{
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        RunBackend<MapPolicy>(corpus, queries);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: " << argv[0] << " <dictionary> [queries]" << endl;
+        return 1;
+    }
+    string corpus = argv[1];
+    size_t queryCount = argc > 2 ? atol(argv[2]) : 10000;
+
+    // one seeded typo per query, so lookups go through the deletes table
+    vector<string> terms = symspell::bench::ReadTerms(corpus, 1);
+    vector<string> queries = symspell::bench::GenerateQueries(terms, queryCount, 1, 42);
+    if (queries.empty())
+    {
+        cerr << "no terms in " << corpus << endl;
+        return 1;
+    }
+
+    printf("%-14s %10s %10s %10s %10s %10s %10s %10s %10s\n", "backend", "words", "entries", "rss_mb", "est_mb", "load_s", "top_us", "closest_us", "all_us");
+    fflush(stdout);
+    ForkBackend<symspell::StdMapPolicy>(corpus, queries);
+    ForkBackend<symspell::FlatMapPolicy>(corpus, queries);
+    ForkBackend<symspell::ArenaMapPolicy>(corpus, queries);
+    return 0;
+}
@@ -0,0 +1,295 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include "../include/symspell.h"
+#include "benchutils.h"
+
+using namespace std;
+
+// Replays a query log against a dictionary with N client threads and reports latency as a log-linear
+// histogram (p50/p90/p99/p99.9/max), throughput and the slowest queries with their work counters, as JSON.
+//
+// Closed loop: every thread sends its next query as soon as the previous one returns. Open loop: query i
+// is due at a fixed arrival rate (--rate) or at its logged timestamp (--timestamps, scaled by --speed), and
+// its latency counts from the time it was due, so a stalled engine shows up as queueing delay instead of
+// being hidden by clients that slowed down with it.
+
+namespace {
+    struct Options
+    {
+        string dictionary;
+        string queryLog;
+        int termIndex = 1;
+        int countIndex = 0;
+        int threads = 1;
+        bool openLoop = false;
+        double rate = 0;
+        bool timestamps = false;
+        double speed = 1;
+        string op = "lookup";
+        symspell::Verbosity verbosity = symspell::Verbosity::Top;
+        int maxEditDistance = defaultMaxEditDistance;
+        int repeat = 1;
+        size_t slowest = 10;
+        symspell::LookupOptions budget;
+    };
+
+    struct Query
+    {
+        string text;
+        // seconds since the first logged query, or -1 without --timestamps
+        double at = -1;
+    };
+
+    struct Sample
+    {
+        uint64_t latencyNs;
+        size_t query;
+        symspell::LookupStats stats;
+
+        bool operator<(const Sample& other) const { return latencyNs > other.latencyNs; }
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> <query-log> [--threads N] [--mode closed|open] [--rate QPS]"
+             << " [--timestamps] [--speed X] [--op lookup|segment] [--verbosity top|closest|all] [--max-edit-distance D]"
+             << " [--repeat R] [--slowest K] [--budget-us US] [--budget-distances N] [--budget-entries N] [--distance-by-length D0,D1,...] [--term-index I] [--count-index I]" << endl;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--threads" && hasValue) options.threads = max(1, atoi(argv[++i]));
+            else if (arg == "--rate" && hasValue) options.rate = atof(argv[++i]);
+            else if (arg == "--timestamps") options.timestamps = true;
+            else if (arg == "--speed" && hasValue) options.speed = atof(argv[++i]);
+            else if (arg == "--op" && hasValue) options.op = argv[++i];
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--repeat" && hasValue) options.repeat = max(1, atoi(argv[++i]));
+            else if (arg == "--slowest" && hasValue) options.slowest = atol(argv[++i]);
+            else if (arg == "--budget-us" && hasValue) options.budget.maxMicroseconds = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--budget-distances" && hasValue) options.budget.maxDistanceComputations = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--budget-entries" && hasValue) options.budget.maxEntriesScanned = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--distance-by-length" && hasValue)
+            {
+                vector<int> table;
+                stringstream values(argv[++i]);
+                string value;
+                while (std::getline(values, value, ',')) table.push_back(atoi(value.c_str()));
+                options.budget.maxEditDistanceByLength = symspell::EditDistanceByLength(table);
+            }
+            else if (arg == "--term-index" && hasValue) options.termIndex = atoi(argv[++i]);
+            else if (arg == "--count-index" && hasValue) options.countIndex = atoi(argv[++i]);
+            else if (arg == "--mode" && hasValue)
+            {
+                string value = argv[++i];
+                if (value == "closed") options.openLoop = false;
+                else if (value == "open") options.openLoop = true;
+                else return false;
+            }
+            else if (arg == "--verbosity" && hasValue)
+            {
+                string value = argv[++i];
+                if (value == "top") options.verbosity = symspell::Verbosity::Top;
+                else if (value == "closest") options.verbosity = symspell::Verbosity::Closest;
+                else if (value == "all") options.verbosity = symspell::Verbosity::All;
+                else return false;
+            }
+            else if (arg[0] != '-' && options.dictionary.empty()) options.dictionary = arg;
+            else if (arg[0] != '-' && options.queryLog.empty()) options.queryLog = arg;
+            else return false;
+        }
+        if (options.op != "lookup" && options.op != "segment") return false;
+        if (options.openLoop && options.rate <= 0 && !options.timestamps) return false;
+        if (options.speed <= 0) return false;
+        return !options.dictionary.empty() && !options.queryLog.empty() && options.maxEditDistance >= 0;
+    }
+
+    /// <summary>One query per line; with timestamps, "seconds<TAB>query" lines (absolute or relative seconds).</summary>
+    vector<Query> ReadLog(const Options& options)
+    {
+        vector<Query> queries;
+        ifstream stream(options.queryLog);
+        string line;
+        double first = -1;
+        while (std::getline(stream, line))
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+            Query query;
+            size_t tab = line.find('\t');
+            if (options.timestamps && tab != string::npos)
+            {
+                double at = atof(line.substr(0, tab).c_str());
+                if (first < 0) first = at;
+                query.at = at - first;
+                query.text = line.substr(tab + 1);
+            }
+            else query.text = line;
+            queries.push_back(query);
+        }
+        return queries;
+    }
+
+    void WriteStats(symspell::bench::JsonWriter& json, const symspell::LookupStats& stats)
+    {
+        json.BeginObject("counters")
+            .Value("candidates_generated", (size_t)stats.candidatesGenerated)
+            .Value("buckets_probed", (size_t)stats.bucketsProbed)
+            .Value("buckets_hit", (size_t)stats.bucketsHit)
+            .Value("filter_rejected", (size_t)stats.filterRejected)
+            .Value("entries_scanned", (size_t)stats.entriesScanned)
+            .Value("entries_skipped", (size_t)stats.entriesSkipped)
+            .Value("distance_computations", (size_t)stats.distanceComputations)
+            .Value("early_exits", (size_t)stats.earlyExits)
+            .Value("truncated", (size_t)stats.truncated)
+            .Value("segmentation_parts", (size_t)stats.segmentationParts)
+            .EndObject();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    vector<Query> log = ReadLog(options);
+    if (log.empty())
+    {
+        cerr << "no queries in " << options.queryLog << endl;
+        return 1;
+    }
+    // with --repeat the log plays again after itself, shifted by its own duration
+    vector<Query> queries;
+    double duration = log.back().at > 0 ? log.back().at : 0;
+    for (int r = 0; r < options.repeat; ++r)
+        for (size_t i = 0; i < log.size(); ++i)
+        {
+            queries.push_back(log[i]);
+            if (log[i].at >= 0) queries.back().at += r * duration;
+        }
+
+    symspell::SymSpell symSpell(defaultInitialCapacity, options.maxEditDistance);
+    symspell::bench::Timer load;
+    if (!symSpell.LoadDictionary(options.dictionary, options.termIndex, options.countIndex))
+    {
+        cerr << "cannot read " << options.dictionary << endl;
+        return 1;
+    }
+    double loadSeconds = load.Seconds();
+    size_t maxWordLength = 0;
+    vector<string> terms = symspell::bench::ReadTerms(options.dictionary, options.termIndex);
+    for (size_t i = 0; i < terms.size(); ++i) maxWordLength = max(maxWordLength, terms[i].size());
+
+    // when query i is due, in nanoseconds after the start; closed loop has no schedule
+    vector<uint64_t> due;
+    if (options.openLoop)
+    {
+        due.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            double at = options.timestamps && queries[i].at >= 0 ? queries[i].at / options.speed : i / options.rate;
+            due[i] = (uint64_t)(at * 1e9);
+        }
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> truncated(0);
+    vector<symspell::bench::LatencyHistogram> histograms(options.threads);
+    vector<vector<Sample>> slowest(options.threads);
+    vector<symspell::LookupStats> totals(options.threads);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    auto client = [&](int thread)
+    {
+        vector<std::unique_ptr<symspell::SuggestItem>> items;
+        vector<Sample>& heap = slowest[thread];
+        for (size_t i = next++; i < queries.size(); i = next++)
+        {
+            std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+            if (options.openLoop)
+            {
+                std::chrono::steady_clock::time_point at = start + std::chrono::nanoseconds(due[i]);
+                // sleeping overshoots by tens of microseconds: sleep to shortly before the query is due, then spin
+                if (at - sent > std::chrono::microseconds(200)) std::this_thread::sleep_until(at - std::chrono::microseconds(100));
+                while (std::chrono::steady_clock::now() < at) { }
+                sent = at;
+            }
+            string query = queries[i].text;
+            symspell::LookupStats stats;
+            if (options.op == "segment") symSpell.WordSegmentation(query, options.maxEditDistance, maxWordLength, &stats);
+            else if (symSpell.Lookup(query, options.verbosity, options.maxEditDistance, options.budget, items, &stats) == symspell::LookupStatus::Truncated) ++truncated;
+            uint64_t latency = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sent).count();
+            histograms[thread].Record(latency);
+            totals[thread] += stats;
+            if (options.slowest == 0) continue;
+            // min heap of the slowest queries of this thread
+            if (heap.size() < options.slowest || latency > heap.front().latencyNs)
+            {
+                Sample sample = { latency, i, stats };
+                heap.push_back(sample);
+                std::push_heap(heap.begin(), heap.end());
+                if (heap.size() > options.slowest)
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.pop_back();
+                }
+            }
+        }
+    };
+    vector<std::thread> clients;
+    for (int t = 1; t < options.threads; ++t) clients.push_back(std::thread(client, t));
+    client(0);
+    for (size_t t = 0; t < clients.size(); ++t) clients[t].join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    symspell::bench::LatencyHistogram histogram;
+    symspell::LookupStats total;
+    vector<Sample> samples;
+    for (int t = 0; t < options.threads; ++t)
+    {
+        histogram.Merge(histograms[t]);
+        total += totals[t];
+        samples.insert(samples.end(), slowest[t].begin(), slowest[t].end());
+    }
+    std::sort(samples.begin(), samples.end());
+    if (samples.size() > options.slowest) samples.resize(options.slowest);
+
+    symspell::bench::JsonWriter json;
+    json.BeginObject();
+    json.Value("dictionary", options.dictionary).Value("query_log", options.queryLog)
+        .Value("op", options.op).Value("mode", options.openLoop ? "open" : "closed").Value("threads", options.threads)
+        .Value("offered_qps", options.openLoop && !options.timestamps ? options.rate : 0.0)
+        .Value("queries", queries.size()).Value("load_seconds", loadSeconds)
+        .Value("seconds", seconds).Value("throughput_qps", queries.size() / seconds)
+        .Value("truncated", truncated.load())
+        .Value("stats_enabled", symspell::LookupStatsRegistry::Enabled() ? "yes" : "no");
+    json.BeginObject("latency_ns")
+        .Value("mean", histogram.Mean())
+        .Value("p50", (size_t)histogram.Percentile(0.50))
+        .Value("p90", (size_t)histogram.Percentile(0.90))
+        .Value("p99", (size_t)histogram.Percentile(0.99))
+        .Value("p999", (size_t)histogram.Percentile(0.999))
+        .Value("max", (size_t)histogram.Max())
+        .EndObject();
+    WriteStats(json, total);
+    json.BeginArray("slowest");
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        json.BeginObject().Value("query", queries[samples[i].query].text).Value("line", samples[i].query % log.size() + 1)
+            .Value("latency_ns", (size_t)samples[i].latencyNs);
+        WriteStats(json, samples[i].stats);
+        json.EndObject();
+    }
+    json.EndArray();
+    json.EndObject();
+    cout << json.str() << endl;
+    return 0;
+}
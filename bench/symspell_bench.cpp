@@ -0,0 +1,227 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include "../include/symspell.h"
+#include "benchutils.h"
+
+using namespace std;
+
+// Reproducible microbenchmark: dictionary load, memory, and lookup latency per verbosity and
+// edit distance on seeded synthetic typos, plus lookup throughput at 1..N threads.
+// The report is a single JSON object on stdout so runs of different builds can be diffed.
+
+namespace {
+    struct Options
+    {
+        string dictionary;
+        int termIndex = 1;
+        int countIndex = 0;
+        size_t queries = 10000;
+        uint64_t seed = 42;
+        int threads = (int)max(1u, std::thread::hardware_concurrency());
+        int maxEditDistance = defaultMaxEditDistance;
+        int prefixLength = defaultPrefixLength;
+        bool diagnose = false;
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> [--queries N] [--seed S] [--threads N]"
+             << " [--max-edit-distance D] [--prefix-length P] [--term-index I] [--count-index I] [--diagnose]" << endl;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--queries" && hasValue) options.queries = atol(argv[++i]);
+            else if (arg == "--seed" && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--threads" && hasValue) options.threads = max(1, atoi(argv[++i]));
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--prefix-length" && hasValue) options.prefixLength = atoi(argv[++i]);
+            else if (arg == "--term-index" && hasValue) options.termIndex = atoi(argv[++i]);
+            else if (arg == "--count-index" && hasValue) options.countIndex = atoi(argv[++i]);
+            else if (arg == "--diagnose") options.diagnose = true;
+            else if (arg[0] != '-' && options.dictionary.empty()) options.dictionary = arg;
+            else return false;
+        }
+        return !options.dictionary.empty();
+    }
+
+    const char* VerbosityName(symspell::Verbosity verbosity)
+    {
+        switch (verbosity)
+        {
+        case symspell::Verbosity::Top: return "top";
+        case symspell::Verbosity::Closest: return "closest";
+        default: return "all";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    symspell::bench::JsonWriter json;
+    json.BeginObject();
+    json.Value("dictionary", options.dictionary).Value("seed", (size_t)options.seed).Value("queries", options.queries);
+
+    size_t rssBefore = symspell::bench::CurrentRss();
+    symspell::bench::Timer timer;
+    symspell::SymSpell symSpell(defaultInitialCapacity, options.maxEditDistance, options.prefixLength);
+    if (!symSpell.LoadDictionary(options.dictionary, options.termIndex, options.countIndex))
+    {
+        cerr << "cannot open " << options.dictionary << endl;
+        return 1;
+    }
+    double loadSeconds = timer.Seconds();
+    size_t rssAfter = symspell::bench::CurrentRss();
+
+    json.BeginObject("load")
+        .Value("seconds", loadSeconds)
+        .Value("words", symSpell.WordCount())
+        .Value("entries", symSpell.EntryCount())
+        .Value("max_word_length", symSpell.MaxLength())
+        .Value("index_rss_bytes", rssAfter > rssBefore ? rssAfter - rssBefore : (size_t)0)
+        .Value("peak_rss_bytes", symspell::bench::PeakRss());
+    if (options.diagnose)
+    {
+        symspell::IndexDiagnostics diagnostics = symSpell.DiagnoseIndex();
+        json.Value("collision_rate", diagnostics.CollisionRate()).Value("foreign_rate", diagnostics.ForeignRate());
+    }
+    json.EndObject();
+
+    symspell::MemoryUsage usage = symSpell.MemoryUsage();
+    json.BeginObject("memory")
+        .Value("words_bytes", usage.wordsBytes)
+        .Value("below_threshold_words_bytes", usage.belowThresholdWordsBytes)
+        .Value("deletes_table_bytes", usage.deletesTableBytes)
+        .Value("bucket_vectors_bytes", usage.bucketVectorsBytes)
+        .Value("suggestion_strings_bytes", usage.suggestionStringsBytes)
+        .Value("staging_bytes", usage.stagingBytes)
+        .Value("total_bytes", usage.TotalBytes())
+        .Value("average_bucket_length", usage.AverageBucketLength())
+        .Value("max_bucket_length", usage.maxBucketLength)
+        .EndObject();
+
+    vector<string> terms = symspell::bench::ReadTerms(options.dictionary, options.termIndex);
+
+    // latency per (typo edits, verbosity); typos beyond maxEditDistance measure the miss path
+    vector<std::unique_ptr<symspell::SuggestItem>> items;
+    symspell::Verbosity verbosities[3] = { symspell::Verbosity::Top, symspell::Verbosity::Closest, symspell::Verbosity::All };
+    json.BeginArray("lookup");
+    for (int edits = 0; edits <= options.maxEditDistance + 1; ++edits)
+    {
+        vector<string> queries = symspell::bench::GenerateQueries(terms, options.queries, edits, options.seed + edits);
+        for (int v = 0; v < 3; ++v)
+        {
+            vector<double> latencies;
+            latencies.reserve(queries.size());
+            size_t found = 0;
+            symspell::LookupStats before = symspell::LookupStatsRegistry::Snapshot();
+            symspell::bench::Timer total;
+            for (size_t i = 0; i < queries.size(); ++i)
+            {
+                symspell::bench::Timer one;
+                symSpell.Lookup(queries[i], verbosities[v], items);
+                latencies.push_back(one.Nanoseconds());
+                if (!items.empty()) ++found;
+            }
+            double seconds = total.Seconds();
+            symspell::LookupStats work = symspell::LookupStatsRegistry::Snapshot() - before;
+            sort(latencies.begin(), latencies.end());
+            json.BeginObject()
+                .Value("typo_edits", edits)
+                .Value("verbosity", VerbosityName(verbosities[v]))
+                .Value("mean_ns", seconds * 1e9 / max((size_t)1, queries.size()))
+                .Value("p50_ns", symspell::bench::Percentile(latencies, 0.50))
+                .Value("p99_ns", symspell::bench::Percentile(latencies, 0.99))
+                .Value("max_ns", latencies.empty() ? 0.0 : latencies.back())
+                .Value("found_rate", (double)found / max((size_t)1, queries.size()));
+            if (symspell::LookupStatsRegistry::Enabled())
+            {
+                double n = (double)max((uint64_t)1, work.lookups);
+                json.Value("candidates_per_lookup", work.candidatesGenerated / n)
+                    .Value("buckets_hit_per_lookup", work.bucketsHit / n)
+                    .Value("entries_scanned_per_lookup", work.entriesScanned / n)
+                    .Value("distance_computations_per_lookup", work.distanceComputations / n);
+            }
+            json.EndObject();
+        }
+    }
+    json.EndArray();
+
+    // prefix completion on the first 1..4 bytes of dictionary words
+    symspell::bench::Timer buildTimer;
+    symSpell.BuildPrefixIndex();
+    double prefixBuildSeconds = buildTimer.Seconds();
+    json.BeginArray("complete");
+    for (size_t prefixLen = 1; prefixLen <= 4; ++prefixLen)
+    {
+        vector<string> prefixes = symspell::bench::GenerateQueries(terms, options.queries, 0, options.seed);
+        for (size_t i = 0; i < prefixes.size(); ++i) prefixes[i].resize(min(prefixLen, prefixes[i].size()));
+        vector<double> latencies;
+        latencies.reserve(prefixes.size());
+        for (size_t i = 0; i < prefixes.size(); ++i)
+        {
+            symspell::bench::Timer one;
+            symSpell.Complete(prefixes[i], 10, items);
+            latencies.push_back(one.Nanoseconds());
+        }
+        sort(latencies.begin(), latencies.end());
+        json.BeginObject()
+            .Value("prefix_length", prefixLen)
+            .Value("k", 10)
+            .Value("build_seconds", prefixBuildSeconds)
+            .Value("p50_ns", symspell::bench::Percentile(latencies, 0.50))
+            .Value("p99_ns", symspell::bench::Percentile(latencies, 0.99))
+            .EndObject();
+    }
+    json.EndArray();
+
+    // throughput: every thread runs the whole query list against the shared index
+    vector<string> queries = symspell::bench::GenerateQueries(terms, options.queries, 1, options.seed);
+    vector<int> threadCounts;
+    for (int threadCount = 1; threadCount < options.threads; threadCount *= 2) threadCounts.push_back(threadCount);
+    threadCounts.push_back(options.threads);
+    json.BeginArray("threads");
+    for (size_t c = 0; c < threadCounts.size(); ++c)
+    {
+        int threadCount = threadCounts[c];
+        vector<std::thread> workers;
+        symspell::bench::Timer wall;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers.push_back(std::thread([&symSpell, &queries]()
+            {
+                vector<std::unique_ptr<symspell::SuggestItem>> results;
+                for (size_t i = 0; i < queries.size(); ++i)
+                {
+                    string query = queries[i];
+                    symSpell.Lookup(query, symspell::Verbosity::Top, results);
+                }
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+        double seconds = wall.Seconds();
+        json.BeginObject()
+            .Value("threads", threadCount)
+            .Value("seconds", seconds)
+            .Value("lookups_per_second", threadCount * queries.size() / seconds)
+            .EndObject();
+    }
+    json.EndArray();
+
+    json.Value("peak_rss_bytes", symspell::bench::PeakRss());
+    json.EndObject();
+    cout << json.str() << endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+#ifndef SYMSPELL_ARENA_H
+#define SYMSPELL_ARENA_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+#define defaultArenaBlockSize (4 << 20)
+
+    /// <summary>How MonotonicArena maps its blocks.</summary>
+    enum class HugePages
+    {
+        None,
+        /// <summary>Regular pages advised for transparent huge pages (madvise MADV_HUGEPAGE).</summary>
+        Transparent,
+        /// <summary>Pages from the reserved huge page pool (MAP_HUGETLB); falls back to Transparent when the pool is empty.</summary>
+        Explicit
+    };
+
+/// <summary>Bump allocator over large blocks; memory is only given back all at once, by Release or destruction.</summary>
+/// Blocks are mapped directly from the kernel (aligned_alloc off Linux), optionally on huge pages so a
+/// dictionary of millions of small nodes costs few TLB entries. Deallocate is a no-op: memory of erased
+/// elements and of outgrown hash tables stays in the arena until Release. Requests larger than a
+/// quarter block get a block of their own, so a growing hash table does not waste the rest of the
+/// current block. Not thread safe; lookups do not allocate from it (see ArenaMapPolicy).
+class MonotonicArena
+{
+public:
+    explicit MonotonicArena(size_t blockSize = defaultArenaBlockSize, HugePages hugePages = HugePages::None);
+    ~MonotonicArena();
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment)
+    {
+        size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes > capacity) return AllocateSlow(bytes, alignment);
+        used = offset + bytes;
+        return current + offset;
+    }
+    /// <summary>Unmaps every block. Objects still holding arena memory must not be used afterwards.</summary>
+    void Release();
+
+    /// <summary>Bytes handed out, including alignment padding.</summary>
+    size_t BytesUsed() const { return usedBefore + used; }
+    /// <summary>Bytes of all blocks.</summary>
+    size_t BytesReserved() const { return reserved; }
+    size_t BlockCount() const { return blocks.size(); }
+    /// <summary>Blocks that came from the explicit huge page pool.</summary>
+    size_t HugeTlbBlocks() const { return hugeTlbBlocks; }
+
+private:
+    struct Block
+    {
+        void* base;
+        size_t size;
+        bool mapped;
+    };
+
+    void* AllocateSlow(size_t bytes, size_t alignment);
+    Block Map(size_t bytes);
+
+    size_t blockSize;
+    HugePages hugePages;
+    vector<Block> blocks;
+    char* current = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t usedBefore = 0;
+    size_t reserved = 0;
+    size_t hugeTlbBlocks = 0;
+};
+
+/// <summary>Allocator on a MonotonicArena; without an arena (the default one) it uses the heap.</summary>
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ArenaAllocator() : arena(nullptr) { }
+    explicit ArenaAllocator(MonotonicArena* arena) : arena(arena) { }
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.Arena()) { }
+
+    T* allocate(size_t n)
+    {
+        if (arena == nullptr) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t)
+    {
+        if (arena == nullptr) ::operator delete(p);
+    }
+
+    MonotonicArena* Arena() const { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.Arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.Arena(); }
+
+private:
+    MonotonicArena* arena;
+};
+}
+#endif // SYMSPELL_ARENA_H
@@ -0,0 +1,106 @@
+#ifndef SYMSPELL_ASYNCLOOKUP_H
+#define SYMSPELL_ASYNCLOOKUP_H
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <thread>
+#include "symspell.h"
+
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Outcome of an asynchronous lookup.</summary>
+struct AsyncLookupResult
+{
+    enum Status
+    {
+        /// <summary>The lookup ran; suggestions holds its result.</summary>
+        Done,
+        /// <summary>Cancel, CancelAll or Shutdown removed the lookup before it ran.</summary>
+        Cancelled,
+        /// <summary>The queue was full under Backpressure::Reject, or the executor was shut down.</summary>
+        Rejected,
+        /// <summary>Lookup threw; error holds the message.</summary>
+        Failed
+    };
+
+    uint64_t ticket = 0;
+    Status status = Done;
+    vector<std::unique_ptr<symspell::SuggestItem>> suggestions;
+    string error;
+};
+
+/// <summary>Runs lookups of one dictionary on a bounded pool of worker threads.</summary>
+/// Callers on an event loop hand a word over and get the suggestions later, through a future or a
+/// completion callback, instead of blocking in Lookup. At most queueCapacity lookups wait for a
+/// worker; beyond that LookupAsync either blocks the caller (Backpressure::Block) or completes the
+/// lookup at once as Rejected (Backpressure::Reject, the choice for event loop threads).
+/// Waiting lookups can be cancelled by ticket; a lookup already running is always finished.
+///
+/// Callbacks run on a worker thread for Done and Failed, on the thread calling Cancel, CancelAll or
+/// Shutdown for Cancelled, and on the calling thread for Rejected; they should only hand the result
+/// back to their owner (post it to the event loop, resume a coroutine) and must not block.
+/// The engine must not get new words while the executor is running.
+template <typename Engine = SymSpell>
+class BasicAsyncLookup
+{
+public:
+    enum class Backpressure { Block, Reject };
+    typedef std::function<void(AsyncLookupResult&)> Callback;
+
+    BasicAsyncLookup(Engine& engine, size_t threads = 1, size_t queueCapacity = 1024, Backpressure backpressure = Backpressure::Block);
+    /// <summary>Cancels waiting lookups and joins the workers (see Shutdown).</summary>
+    ~BasicAsyncLookup();
+
+    /// <summary>Queues a lookup and returns its ticket; done receives the result.</summary>
+    uint64_t LookupAsync(const string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, Callback done);
+    /// <summary>Queues a lookup; the future receives the result. ticket, if given, receives its ticket for Cancel.</summary>
+    std::future<AsyncLookupResult> LookupAsync(const string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, uint64_t* ticket = nullptr);
+    std::future<AsyncLookupResult> LookupAsync(const string& input, Verbosity verbosity);
+
+    /// <summary>Completes a waiting lookup as Cancelled; false if it already runs, ran or is unknown.</summary>
+    bool Cancel(uint64_t ticket);
+    /// <summary>Cancels every waiting lookup; returns how many there were.</summary>
+    size_t CancelAll();
+    /// <summary>Cancels waiting lookups, lets running ones finish and stops the workers.
+    /// Later LookupAsync calls complete as Rejected.</summary>
+    void Shutdown();
+
+    /// <summary>Lookups waiting for a worker.</summary>
+    size_t Pending();
+    size_t Threads() const { return workers.size(); }
+    size_t QueueCapacity() const { return queueCapacity; }
+
+private:
+    struct Job
+    {
+        uint64_t ticket;
+        string input;
+        Verbosity verbosity;
+        int maxEditDistance;
+        bool includeUnknown;
+        Callback done;
+    };
+
+    void Work();
+    static void Complete(Job& job, AsyncLookupResult::Status status);
+
+    Engine* engine;
+    size_t queueCapacity;
+    Backpressure backpressure;
+    vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable spaceReady;
+    std::deque<Job> jobs;
+    uint64_t nextTicket = 1;
+    bool stopping = false;
+};
+
+typedef BasicAsyncLookup<> AsyncLookup;
+}
+
+#endif // SYMSPELL_ASYNCLOOKUP_H
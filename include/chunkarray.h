@@ -6,14 +6,15 @@
 using namespace std;
 namespace symspell {
 
-template<typename T>
+/// <summary>Growable array in chunks of ChunkSize elements; the chunks come from allocator.</summary>
+template<typename T, typename Allocator = std::allocator<T>>
 class ChunkArray
 {
     public:
-        vector<vector<T>> Values; //todo: use pointer array
+        vector<vector<T, Allocator>> Values; //todo: use pointer array
         size_t Count;
 
-        ChunkArray()
+        explicit ChunkArray(const Allocator& allocator = Allocator()) : allocator(allocator)
         {
             Count = 0;
         }
@@ -21,20 +22,12 @@ class ChunkArray
         void Reserve(size_t initialCapacity)
         {
             size_t chunks = (initialCapacity + ChunkSize - 1) / ChunkSize;
-            Values.resize(chunks);
-            for (size_t i = 0; i < chunks; ++i)
-            {
-                Values[i].resize(ChunkSize);
-            }
+            while (Values.size() < chunks) AddChunk();
         }
 
         size_t Add(T & value)
         {
-            if (Count == Capacity())
-            {
-                Values.push_back(vector<T>());
-                Values[Values.size() - 1].resize(ChunkSize);
-            }
+            if (Count == (size_t)Capacity()) AddChunk();
 
             int row = Row(Count);
             int col = Col(Count);
@@ -43,6 +36,14 @@ class ChunkArray
             return Count++;
         }
 
+        size_t Add(T && value)
+        {
+            if (Count == (size_t)Capacity()) AddChunk();
+
+            Values[Row(Count)][Col(Count)] = std::move(value);
+            return Count++;
+        }
+
         void Clear()
         {
             Count = 0;
@@ -59,6 +60,13 @@ class ChunkArray
         }
 
     private:
+        void AddChunk()
+        {
+            Values.push_back(vector<T, Allocator>(allocator));
+            Values.back().resize(ChunkSize);
+        }
+
+        Allocator allocator;
         const int32_t ChunkSize = 4096; //this must be a power of 2, otherwise can't optimize Row and Col functions
         const int32_t DivShift = 12; // number of bits to shift right to do division by ChunkSize (the bit position of ChunkSize)
         int Row(uint32_t index) { return index >> DivShift; } // same as index / ChunkSize
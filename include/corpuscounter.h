@@ -0,0 +1,69 @@
+#ifndef SYMSPELL_CORPUSCOUNTER_H
+#define SYMSPELL_CORPUSCOUNTER_H
+
+#include "utils.h"
+#include <atomic>
+using namespace std;
+
+namespace symspell {
+#define defaultSketchDepth 4
+
+/// <summary>Word counts of raw text files, counted by several threads.</summary>
+/// Files are cut into chunks at line boundaries; each thread takes chunks from a shared cursor and counts
+/// the words of its lines into its own map, and the maps are merged at the end. Words are maximal runs of
+/// letters in UTF-8 text, with ASCII letters lower cased, close to the legacy CreateDictionary regex
+/// [^\W\d_]+: ASCII and Latin-1 non-letters, general and supplemental punctuation (dashes, quotes,
+/// no-break and other spaces), currency, arrows, math and other symbol blocks, CJK and fullwidth
+/// punctuation and emoji separate words; every other code point counts as a letter. Malformed UTF-8
+/// bytes separate words too.
+///
+/// With a sketch (sketchWidth > 0) counting takes two passes: the first one only adds every word to a
+/// count-min sketch, the second one counts exactly just the words whose sketch estimate reaches
+/// countThreshold. A sketch never underestimates, so no word that reaches the threshold is lost, while
+/// the long tail of rare words never gets a map entry.
+class CorpusCounter
+{
+public:
+    /// <summary>sketchWidth: counters per sketch row (rounded up to a power of two); 0 counts every word exactly.</summary>
+    CorpusCounter(long countThreshold = 1, size_t threads = 1, size_t sketchWidth = 0, size_t sketchDepth = defaultSketchDepth);
+
+    /// <summary>Counts the words of the files, adding to the counts so far; false if a file cannot be read.</summary>
+    /// With a sketch, pass all files to one call: a word that reaches the threshold only in a later call
+    /// misses its occurrences from the earlier ones.
+    bool Count(const vector<string>& paths);
+    /// <summary>Words with their counts, by descending count then word. With a sketch, only words reaching countThreshold.</summary>
+    vector<pair<string, long>> Counts() const;
+    /// <summary>Writes Counts() as "word\tcount" lines, ready for LoadDictionary(path, 0, 1).</summary>
+    bool SaveFrequencies(const string& path) const;
+
+    size_t Words() const { return counts.size(); }
+    /// <summary>Words read in the last Count, including the ones the sketch kept out.</summary>
+    size_t Tokens() const { return tokens; }
+
+private:
+    struct Chunk
+    {
+        size_t file;
+        size_t begin;
+        size_t end;
+    };
+
+    /// <summary>Calls visit(word) for each word of the lines starting in chunk.</summary>
+    template <typename Visit>
+    void ForEachWord(const string& path, const Chunk& chunk, Visit visit) const;
+    void AddToSketch(const string& word);
+    uint32_t SketchEstimate(const string& word) const;
+    /// <summary>Runs work(chunk, thread) over all chunks with the configured threads.</summary>
+    template <typename Work>
+    void RunChunks(const vector<Chunk>& chunks, Work work);
+
+    long countThreshold;
+    size_t threads;
+    size_t sketchDepth;
+    size_t sketchMask = 0;
+    unique_ptr<std::atomic<uint32_t>[]> sketch;
+    size_t tokens = 0;
+    unordered_map<string, long> counts;
+};
+}
+#endif // SYMSPELL_CORPUSCOUNTER_H
@@ -0,0 +1,36 @@
+#ifndef SYMSPELL_COUNTQUANTIZER_H
+#define SYMSPELL_COUNTQUANTIZER_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>16 bit logarithmic codes for word counts.</summary>
+/// Code 0 stands for counts <= 0; code c >= 1 for counts near 2^((c - 1) / Scale), so the 65535 codes
+/// cover 1 .. 2^63 in steps of about 0.067%. Encoding is monotonic: counts whose ratio exceeds
+/// 1 + Step() always get different codes, and counts below about 1500 decode exactly. Decode and Log10
+/// read tables built on first use.
+class CountQuantizer
+{
+public:
+    static uint16_t Encode(long count);
+    /// <summary>Approximate count of code.</summary>
+    static long Decode(uint16_t code) { return Tables().counts[code]; }
+    /// <summary>log10 of the count of code, for log probabilities (log10(count / N) = Log10(code) - log10(N)).</summary>
+    /// Word segmentation reads it through FrozenWordTable::FindLog10 when counts are quantized.
+    static double Log10(uint16_t code) { return Tables().log10Counts[code]; }
+    /// <summary>Relative distance between the counts of neighbouring codes.</summary>
+    static double Step();
+
+private:
+    struct Table
+    {
+        vector<long> counts;
+        vector<double> log10Counts;
+        Table();
+    };
+    static const Table& Tables();
+};
+}
+#endif // SYMSPELL_COUNTQUANTIZER_H
@@ -0,0 +1,96 @@
+#ifndef SYMSPELL_DELETEFILTER_H
+#define SYMSPELL_DELETEFILTER_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+#define defaultFilterBitsPerKey 10
+
+    namespace {
+        // odd multipliers picking one bit in each of the eight words of a block
+        const uint32_t deleteFilterSalts[8] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+        };
+    }
+
+/// <summary>Approximate membership filter over the delete hashes of the deletes index.</summary>
+/// Split block Bloom filter: a key selects one 32 byte block (half a cache line) with the high half of
+/// its hash and sets one bit in each of the block's eight 32 bit words with the low half, so a query
+/// touches a single cache line and has no data dependent branches. Most delete candidates of a lookup
+/// are in no bucket; the filter answers them without probing the (much larger) deletes table.
+/// No false negatives; about 1% false positives at 10 bits per key.
+class DeleteFilter
+{
+public:
+    /// <summary>Empties the filter and sizes it for keys keys.</summary>
+    void Build(size_t keys, double bitsPerKey = defaultFilterBitsPerKey);
+    /// <summary>Releases the filter; an empty filter answers true for every key.</summary>
+    void Clear();
+    bool Empty() const { return blockCount == 0; }
+
+    void Insert(uint64_t hash)
+    {
+        uint32_t* block = Block(hash);
+        uint32_t key = (uint32_t)hash;
+        for (int i = 0; i < 8; ++i) block[i] |= 1U << ((key * deleteFilterSalts[i]) >> 27);
+        ++keys;
+    }
+
+    /// <summary>False only if hash was never inserted.</summary>
+    bool MayContain(uint64_t hash) const
+    {
+        if (blockCount == 0) return true;
+        const uint32_t* block = Block(hash);
+        uint32_t key = (uint32_t)hash;
+        uint32_t missing = 0;
+        for (int i = 0; i < 8; ++i) missing |= ~block[i] & (1U << ((key * deleteFilterSalts[i]) >> 27));
+        return missing == 0;
+    }
+
+    /// <summary>Keys inserted, and the number the filter was sized for.</summary>
+    size_t Keys() const { return keys; }
+    size_t Capacity() const { return capacity; }
+    double BitsPerKey() const { return bitsPerKey; }
+    /// <summary>True once twice as many keys were inserted as the filter was sized for.</summary>
+    bool Overloaded() const { return blockCount != 0 && keys > 2 * capacity; }
+
+    size_t MemoryUsage() const;
+    /// <summary>Fraction of bits set.</summary>
+    double FillRatio() const;
+    /// <summary>Probability that a key never inserted passes, computed from the bits set in every block.</summary>
+    double EstimatedFalsePositiveRate() const;
+
+private:
+    uint32_t* Base() { return (uint32_t*)(((uintptr_t)words.data() + 31) & ~(uintptr_t)31); }
+    const uint32_t* Base() const { return (const uint32_t*)(((uintptr_t)words.data() + 31) & ~(uintptr_t)31); }
+    uint32_t* Block(uint64_t hash) { return Base() + ((((hash >> 32) * blockCount) >> 32) << 3); }
+    const uint32_t* Block(uint64_t hash) const { return Base() + ((((hash >> 32) * blockCount) >> 32) << 3); }
+
+    // blockCount blocks of 8 words, plus slack to align the first block to 32 bytes
+    vector<uint32_t> words;
+    size_t blockCount = 0;
+    size_t keys = 0;
+    size_t capacity = 0;
+    double bitsPerKey = defaultFilterBitsPerKey;
+};
+
+/// <summary>Size and accuracy of the delete filter of a dictionary.</summary>
+class DeleteFilterReport
+{
+public:
+    size_t keys = 0;
+    size_t bytes = 0;
+    double bitsPerKey = 0;
+    double fillRatio = 0;
+    /// <summary>From the bits set in the filter (DeleteFilter::EstimatedFalsePositiveRate).</summary>
+    double estimatedFalsePositiveRate = 0;
+    /// <summary>Share of random hashes absent from deletes that the filter let through.</summary>
+    double measuredFalsePositiveRate = 0;
+    size_t samples = 0;
+
+    std::string ToString() const;
+};
+}
+#endif // SYMSPELL_DELETEFILTER_H
@@ -0,0 +1,149 @@
+#ifndef SYMSPELL_DISTANCEPOLICY_H
+#define SYMSPELL_DISTANCEPOLICY_H
+
+#include "utils.h"
+#include "editdistance.h"
+using namespace std;
+
+namespace symspell {
+
+    namespace {
+        // longest word the inlined distances handle on the stack; longer ones go to the generic functions
+        const int policyMaxLength = 63;
+
+        inline bool IsAscii(const string& s)
+        {
+            for (size_t i = 0; i < s.size(); ++i)
+                if ((unsigned char)s[i] >= 0x80) return false;
+            return true;
+        }
+    }
+
+/// <summary>Levenshtein distance for SymSpellT, inlined into the lookup loop.</summary>
+/// Same result as levenshtein_dist up to maxDistance; returns maxDistance + 1 as soon as a whole DP row
+/// exceeds maxDistance.
+struct LevenshteinDistance
+{
+    static const EditDistance::DistanceAlgorithm algorithm = EditDistance::DistanceAlgorithm::Levenshtein;
+
+    static int Distance(const string& a, const string& b, int maxDistance)
+    {
+        int n = (int)a.size(), m = (int)b.size();
+        if (n > policyMaxLength || m > policyMaxLength) return levenshtein_dist(a, b);
+        if (abs(n - m) > maxDistance) return maxDistance + 1;
+        int rows[2][policyMaxLength + 1];
+        int* previous = rows[0];
+        int* current = rows[1];
+        for (int j = 0; j <= m; ++j) previous[j] = j;
+        for (int i = 1; i <= n; ++i)
+        {
+            current[0] = i;
+            int rowMin = i;
+            for (int j = 1; j <= m; ++j)
+            {
+                int value = min(previous[j] + 1, current[j - 1] + 1);
+                value = min(value, previous[j - 1] + (a[i - 1] != b[j - 1] ? 1 : 0));
+                current[j] = value;
+                rowMin = min(rowMin, value);
+            }
+            if (rowMin > maxDistance) return maxDistance + 1;
+            std::swap(previous, current);
+        }
+        return previous[m];
+    }
+};
+
+/// <summary>Damerau optimal string alignment distance for SymSpellT, inlined into the lookup loop.</summary>
+/// Same result as dl_dist up to maxDistance. dl_dist compares code points, so words with non ASCII
+/// bytes go to dl_dist.
+struct OsaDistance
+{
+    static const EditDistance::DistanceAlgorithm algorithm = EditDistance::DistanceAlgorithm::DamerauOSA;
+
+    static int Distance(const string& a, const string& b, int maxDistance)
+    {
+        int n = (int)a.size(), m = (int)b.size();
+        if (n > policyMaxLength || m > policyMaxLength || !IsAscii(a) || !IsAscii(b)) return dl_dist(a, b);
+        if (abs(n - m) > maxDistance) return maxDistance + 1;
+        int rows[3][policyMaxLength + 1];
+        int* before = rows[0];
+        int* previous = rows[1];
+        int* current = rows[2];
+        for (int j = 0; j <= m; ++j) previous[j] = j;
+        int previousMin = 0;
+        for (int i = 1; i <= n; ++i)
+        {
+            current[0] = i;
+            int rowMin = i;
+            for (int j = 1; j <= m; ++j)
+            {
+                int value = min(previous[j] + 1, current[j - 1] + 1);
+                value = min(value, previous[j - 1] + (a[i - 1] != b[j - 1] ? 1 : 0));
+                if (i >= 2 && j >= 2 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                    value = min(value, before[j - 2] + 1);
+                current[j] = value;
+                rowMin = min(rowMin, value);
+            }
+            // a transposition reads two rows back, so a row over the limit can still lead to one
+            // within it only through the next row; two rows over the limit cannot
+            if (rowMin > maxDistance && previousMin > maxDistance) return maxDistance + 1;
+            previousMin = rowMin;
+            int* recycled = before;
+            before = previous;
+            previous = current;
+            current = recycled;
+        }
+        return previous[m];
+    }
+};
+
+/// <summary>Delete position masks of SymSpellT: every set of at most MaxEd of the first PrefixLen positions.</summary>
+/// Ordered by size, then lexicographically, which is the order in which the breadth first delete
+/// generation of the runtime engine first reaches each delete. Count is a compile time constant, so
+/// candidate buffers can live on the stack.
+template <int PrefixLen, int MaxEd>
+class DeleteMasks
+{
+public:
+    static_assert(PrefixLen > MaxEd && PrefixLen < 32, "PrefixLen");
+
+    static constexpr size_t Combinations(int n, int k) { return k == 0 ? 1 : Combinations(n, k - 1) * (n - k + 1) / k; }
+    static constexpr size_t Total(int n, int k) { return k < 0 ? 0 : Combinations(n, k) + Total(n, k - 1); }
+    static const size_t Count = Total(PrefixLen, MaxEd);
+
+    /// <summary>Masks[i] has Sizes[i] bits set.</summary>
+    static const uint32_t* Masks() { return Table().masks; }
+    static const uint8_t* Sizes() { return Table().sizes; }
+
+private:
+    struct Tables
+    {
+        uint32_t masks[Count];
+        uint8_t sizes[Count];
+
+        Tables()
+        {
+            size_t n = 0;
+            for (int size = 0; size <= MaxEd; ++size) Add(size, 0, 0, size, n);
+        }
+
+        void Add(int size, int from, uint32_t mask, int remaining, size_t& n)
+        {
+            if (remaining == 0)
+            {
+                masks[n] = mask;
+                sizes[n++] = (uint8_t)size;
+                return;
+            }
+            for (int position = from; position < PrefixLen; ++position) Add(size, position + 1, mask | (1U << position), remaining - 1, n);
+        }
+    };
+
+    static const Tables& Table()
+    {
+        static const Tables tables;
+        return tables;
+    }
+};
+}
+#endif // SYMSPELL_DISTANCEPOLICY_H
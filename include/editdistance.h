@@ -31,11 +31,11 @@ public:
         }
     }
 
-    int Compare(string & string1, string & string2, int maxDistance);
+    int Compare(const string & string1, const string & string2, int maxDistance);
 
 private:
     DistanceAlgorithm algorithm;
-    int(*distanceComparer)(string &, string &);
+    int(*distanceComparer)(const string &, const string &);
 };
 }
 #endif // SYMSPELL_EDITDISTANCE_H
@@ -0,0 +1,261 @@
+#ifndef SYMSPELL_FLATMAP_H
+#define SYMSPELL_FLATMAP_H
+
+#include "utils.h"
+
+using namespace std;
+
+namespace symspell {
+
+    /// <summary>Open addressing hash table with Robin Hood linear probing.</summary>
+    /// Slots live in one contiguous array next to a one byte probe distance per slot
+    /// (0 = empty), so a lookup touches one or two cache lines instead of chasing
+    /// list nodes. Deletion uses backward shifting, no tombstones are left behind.
+    template <typename Slot, typename Key, typename KeyOf, typename Hash, typename Equal>
+    class RobinHoodTable
+    {
+    public:
+        class iterator
+        {
+        public:
+            iterator() : table(nullptr), index(npos) { }
+            iterator(RobinHoodTable* table, size_t index) : table(table), index(index) { }
+
+            Slot& operator*() const { return table->slots[index]; }
+            Slot* operator->() const { return &table->slots[index]; }
+            iterator& operator++() { index = table->NextOccupied(index + 1); return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+            // every end iterator compares equal, so cached end() values stay valid across rehashes
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+
+        private:
+            friend class RobinHoodTable;
+            RobinHoodTable* table;
+            size_t index;
+        };
+
+        RobinHoodTable() : mask(0), shift(63), used(0) { }
+
+        iterator begin() { return iterator(this, NextOccupied(0)); }
+        iterator end() { return iterator(this, npos); }
+
+        size_t size() const { return used; }
+        bool empty() const { return used == 0; }
+        size_t bucket_count() const { return slots.size(); }
+
+        /// <summary>Bytes held by the slot and probe distance arrays.</summary>
+        size_t memory_usage() const { return slots.capacity() * sizeof(Slot) + distances.capacity(); }
+
+        void reserve(size_t n)
+        {
+            size_t needed = n + n / 4 + 1;
+            if (needed > slots.size()) Rehash(needed);
+        }
+
+        void clear()
+        {
+            if (used == 0) return;
+            for (size_t i = 0; i < distances.size(); ++i)
+            {
+                if (distances[i] != 0)
+                {
+                    slots[i] = Slot();
+                    distances[i] = 0;
+                }
+            }
+            used = 0;
+        }
+
+        iterator find(const Key& key)
+        {
+            size_t index = FindIndex(key);
+            return iterator(this, index);
+        }
+
+        size_t count(const Key& key) { return FindIndex(key) == npos ? 0 : 1; }
+
+        size_t erase(const Key& key)
+        {
+            size_t index = FindIndex(key);
+            if (index == npos) return 0;
+
+            // backward shift: pull every following displaced slot one step closer to home
+            size_t next = (index + 1) & mask;
+            while (distances[next] > 1)
+            {
+                slots[index] = std::move(slots[next]);
+                distances[index] = distances[next] - 1;
+                index = next;
+                next = (next + 1) & mask;
+            }
+            slots[index] = Slot();
+            distances[index] = 0;
+            --used;
+            return 1;
+        }
+
+    protected:
+        static const size_t npos = (size_t)-1;
+
+        size_t FindIndex(const Key& key)
+        {
+            if (used == 0) return npos;
+            size_t index = Home(key);
+            for (uint32_t distance = 1; distances[index] >= distance; ++distance)
+            {
+                if (distances[index] == distance && equal(KeyOf()(slots[index]), key)) return index;
+                index = (index + 1) & mask;
+            }
+            return npos;
+        }
+
+        /// <summary>Inserts a slot whose key is known to be absent, returns its final index (npos if a rehash moved it).</summary>
+        size_t InsertNew(Slot slot)
+        {
+            if ((used + 1) * 8 > slots.size() * 7) Rehash(slots.size() * 2);
+
+            size_t index = Home(KeyOf()(slot));
+            size_t placed = npos;
+            uint32_t distance = 1;
+            while (true)
+            {
+                if (distances[index] == 0)
+                {
+                    slots[index] = std::move(slot);
+                    distances[index] = (uint8_t)distance;
+                    ++used;
+                    return placed == npos ? index : placed;
+                }
+                if (distances[index] < distance)
+                {
+                    // Robin Hood: the richer slot gives way to the poorer one
+                    std::swap(slot, slots[index]);
+                    uint32_t displaced = distances[index];
+                    distances[index] = (uint8_t)distance;
+                    distance = displaced;
+                    if (placed == npos) placed = index;
+                }
+                index = (index + 1) & mask;
+                if (++distance == 255)
+                {
+                    // probe sequence too long for the distance byte: grow, then place the slot in hand.
+                    // If it is not the one we were asked to insert, the caller has to look that one up again.
+                    Rehash(slots.size() * 2);
+                    size_t final = InsertNew(std::move(slot));
+                    return placed == npos ? final : npos;
+                }
+            }
+        }
+
+        vector<Slot> slots;
+        vector<uint8_t> distances;
+        size_t mask;
+        uint32_t shift;
+        size_t used;
+        Hash hasher;
+        Equal equal;
+
+    private:
+        size_t Home(const Key& key) const
+        {
+            // Fibonacci mixing so identity hashes (std::hash<size_t>) still spread over the low bits
+            return (size_t)(((uint64_t)hasher(key) * 0x9E3779B97F4A7C15ULL) >> shift) & mask;
+        }
+
+        size_t NextOccupied(size_t index) const
+        {
+            while (index < distances.size() && distances[index] == 0) ++index;
+            return index < distances.size() ? index : npos;
+        }
+
+        void Rehash(size_t minCapacity)
+        {
+            size_t capacity = 16;
+            uint32_t bits = 4;
+            while (capacity < minCapacity) { capacity <<= 1; ++bits; }
+
+            vector<Slot> oldSlots;
+            vector<uint8_t> oldDistances;
+            oldSlots.swap(slots);
+            oldDistances.swap(distances);
+
+            slots.resize(capacity);
+            distances.assign(capacity, 0);
+            mask = capacity - 1;
+            shift = 64 - bits;
+            used = 0;
+            for (size_t i = 0; i < oldDistances.size(); ++i)
+            {
+                if (oldDistances[i] != 0) InsertNew(std::move(oldSlots[i]));
+            }
+        }
+    };
+
+    template <typename K, typename V>
+    struct PairKeyOf
+    {
+        const K& operator()(const pair<K, V>& slot) const { return slot.first; }
+    };
+
+    template <typename K>
+    struct IdentityKeyOf
+    {
+        const K& operator()(const K& slot) const { return slot; }
+    };
+
+    /// <summary>Drop-in replacement for the unordered_map subset used by SymSpell.</summary>
+    template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+    class FlatHashMap : public RobinHoodTable<pair<K, V>, K, PairKeyOf<K, V>, Hash, Equal>
+    {
+        typedef RobinHoodTable<pair<K, V>, K, PairKeyOf<K, V>, Hash, Equal> Table;
+    public:
+        typedef typename Table::iterator iterator;
+
+        FlatHashMap() { }
+        explicit FlatHashMap(size_t initialCapacity) { this->reserve(initialCapacity); }
+
+        V& operator[](const K& key)
+        {
+            size_t index = this->FindIndex(key);
+            if (index == Table::npos)
+            {
+                index = this->InsertNew(pair<K, V>(key, V()));
+                if (index == Table::npos) index = this->FindIndex(key);
+            }
+            return this->slots[index].second;
+        }
+
+        pair<iterator, bool> insert(const pair<K, V>& value)
+        {
+            size_t index = this->FindIndex(value.first);
+            if (index != Table::npos) return make_pair(iterator(this, index), false);
+            index = this->InsertNew(value);
+            if (index == Table::npos) index = this->FindIndex(value.first);
+            return make_pair(iterator(this, index), true);
+        }
+    };
+
+    /// <summary>Drop-in replacement for the unordered_set subset used by SymSpell.</summary>
+    template <typename K, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+    class FlatHashSet : public RobinHoodTable<K, K, IdentityKeyOf<K>, Hash, Equal>
+    {
+        typedef RobinHoodTable<K, K, IdentityKeyOf<K>, Hash, Equal> Table;
+    public:
+        typedef typename Table::iterator iterator;
+
+        FlatHashSet() { }
+        explicit FlatHashSet(size_t initialCapacity) { this->reserve(initialCapacity); }
+
+        pair<iterator, bool> insert(const K& value)
+        {
+            size_t index = this->FindIndex(value);
+            if (index != Table::npos) return make_pair(iterator(this, index), false);
+            index = this->InsertNew(value);
+            if (index == Table::npos) index = this->FindIndex(value);
+            return make_pair(iterator(this, index), true);
+        }
+    };
+}
+
+#endif // SYMSPELL_FLATMAP_H
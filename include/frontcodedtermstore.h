@@ -0,0 +1,66 @@
+#ifndef SYMSPELL_FRONTCODEDTERMSTORE_H
+#define SYMSPELL_FRONTCODEDTERMSTORE_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+#define defaultTermBlockSize 16
+
+/// <summary>Sorted, front coded set of terms; a term's id is its rank.</summary>
+/// Terms are grouped in blocks of blockSize. The first term of a block is stored whole, every other
+/// one as the length of the prefix it shares with its predecessor plus the remaining bytes (lengths
+/// as varints). Id -> term decodes at most one block; term -> id binary searches the block heads,
+/// then decodes one block. Sorted neighbours share long prefixes, so a term takes a few bytes plus
+/// 4 bytes of block offset per block, instead of a string object and a hash node.
+class FrontCodedTermStore
+{
+public:
+    explicit FrontCodedTermStore(size_t blockSize = defaultTermBlockSize);
+
+    /// <summary>Replaces the store with terms (sorted and deduplicated here).</summary>
+    void Build(vector<string> terms);
+    void Clear();
+    size_t Size() const { return count; }
+    bool Empty() const { return count == 0; }
+
+    /// <summary>Term with the given id (0 <= id < Size()).</summary>
+    void Term(uint32_t id, string& term) const;
+    string Term(uint32_t id) const { string term; Term(id, term); return term; }
+    /// <summary>Id of term; false if the store does not hold it.</summary>
+    bool Find(const string& term, uint32_t& id) const;
+
+    /// <summary>Calls visit(id, term) for every term in id order, decoding each block once.</summary>
+    template <typename Visit>
+    void ForEach(Visit visit) const
+    {
+        string term;
+        for (size_t block = 0; block < blockOffsets.size(); ++block)
+        {
+            const uint8_t* p = data.data() + blockOffsets[block];
+            size_t first = block * blockSize, last = min(count, first + blockSize);
+            for (size_t id = first; id < last; ++id)
+            {
+                p = Next(p, id == first, term);
+                visit((uint32_t)id, term);
+            }
+        }
+    }
+
+    size_t MemoryUsage() const;
+
+private:
+    /// <summary>Decodes the entry at p into term (which holds the previous term unless head) and returns the next entry.</summary>
+    static const uint8_t* Next(const uint8_t* p, bool head, string& term);
+    static const uint8_t* ReadVarint(const uint8_t* p, size_t& value);
+    static void WriteVarint(vector<uint8_t>& out, size_t value);
+    /// <summary>Compares the head term of block with term, without copying it.</summary>
+    int CompareHead(size_t block, const string& term) const;
+
+    size_t blockSize;
+    size_t count = 0;
+    vector<uint8_t> data;
+    vector<uint32_t> blockOffsets;
+};
+}
+#endif // SYMSPELL_FRONTCODEDTERMSTORE_H
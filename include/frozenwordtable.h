@@ -0,0 +1,102 @@
+#ifndef SYMSPELL_FROZENWORDTABLE_H
+#define SYMSPELL_FROZENWORDTABLE_H
+
+#include "utils.h"
+#include "countquantizer.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Read only word -> count table addressed by a minimal perfect hash.</summary>
+/// Words are spread over buckets of about four by their hash; each bucket stores a pilot chosen at
+/// build time so that its words land on free slots, and the n words fill exactly n slots
+/// (hash and displace, as in PTHash). A slot keeps the word's full 64 bit hash as fingerprint next
+/// to its count, so a query is one hash, one pilot read and one slot read, with no key comparison:
+/// a word that is not in the table is reported known only if its hash equals that of the word in
+/// its slot (probability 2^-64). The table cannot change after Build.
+/// With quantized counts a slot is a single 64 bit word: the upper 48 bits of the hash and the
+/// CountQuantizer code of the count, halving the table at the price of approximate counts and a
+/// 2^-48 false positive rate.
+class FrozenWordTable
+{
+public:
+    /// <summary>Replaces the table with words; throws invalid_argument on duplicate words.</summary>
+    void Build(const vector<pair<string, long>>& words, bool quantizeCounts = false);
+    void Clear();
+    bool Empty() const { return size == 0; }
+    size_t Size() const { return size; }
+    bool Quantized() const { return !packed.empty(); }
+
+    /// <summary>True if word is in the table; count, if given, receives its count.</summary>
+    bool Find(const string& word, long* count = nullptr) const
+    {
+        if (size == 0) return false;
+        uint64_t hash = hash64(word.data(), word.size(), seed);
+        size_t position = Position(hash);
+        if (!packed.empty())
+        {
+            uint64_t slot = packed[position];
+            if ((slot ^ hash) >> countCodeBits) return false;
+            if (count != nullptr) *count = CountQuantizer::Decode((uint16_t)slot);
+            return true;
+        }
+        const Slot& slot = slots[position];
+        if (slot.hash != hash) return false;
+        if (count != nullptr) *count = slot.count;
+        return true;
+    }
+
+    /// <summary>Find giving log10 of the count; with quantized counts it is read from CountQuantizer's table, not computed.</summary>
+    bool FindLog10(const string& word, double& log10Count) const
+    {
+        if (size == 0) return false;
+        uint64_t hash = hash64(word.data(), word.size(), seed);
+        size_t position = Position(hash);
+        if (!packed.empty())
+        {
+            uint64_t slot = packed[position];
+            if ((slot ^ hash) >> countCodeBits) return false;
+            log10Count = CountQuantizer::Log10((uint16_t)slot);
+            return true;
+        }
+        const Slot& slot = slots[position];
+        if (slot.hash != hash) return false;
+        log10Count = log10((double)slot.count);
+        return true;
+    }
+
+    /// <summary>Find for words[0..n): known[i] = 1 if words[i] is in the table, counts[i] its count (0 if not).</summary>
+    /// Slots of a group of words are prefetched before they are compared, and with threads > 1 the
+    /// words are split in contiguous ranges checked in parallel. counts may be null.
+    void FindBatch(const string* words, size_t n, uint8_t* known, long* counts = nullptr, size_t threads = 1) const;
+
+    size_t MemoryUsage() const;
+
+private:
+    struct Slot
+    {
+        uint64_t hash;
+        long count;
+    };
+
+    size_t Bucket(uint64_t hash) const { return (size_t)(((hash >> 32) * buckets) >> 32); }
+    size_t Position(uint64_t hash, uint32_t pilot) const
+    {
+        uint64_t mixed = (hash ^ (pilot * 0xc6a4a7935bd1e995ULL)) * 0x9e3779b97f4a7c15ULL;
+        return (size_t)(((mixed >> 32) * size) >> 32);
+    }
+    size_t Position(uint64_t hash) const { return Position(hash, pilots[Bucket(hash)]); }
+    void FindRange(const string* words, size_t n, uint8_t* known, long* counts) const;
+    bool TryBuild(const vector<pair<string, long>>& words, uint64_t seed, bool quantizeCounts);
+    static const int countCodeBits = 16;
+
+    uint64_t seed = defaultHashSeed;
+    size_t buckets = 0;
+    vector<uint32_t> pilots;
+    size_t size = 0;
+    // one of the two holds the slots, depending on quantizeCounts
+    vector<Slot> slots;
+    vector<uint64_t> packed;
+};
+}
+#endif // SYMSPELL_FROZENWORDTABLE_H
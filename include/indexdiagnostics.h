@@ -0,0 +1,41 @@
+#ifndef SYMSPELL_INDEXDIAGNOSTICS_H
+#define SYMSPELL_INDEXDIAGNOSTICS_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Hash collision report for the deletes index.</summary>
+/// deletes is keyed by the hash of a delete string alone, so two delete strings with the same
+/// hash share one bucket, and Lookup has to filter out the entries of the other string.
+class IndexDiagnostics
+{
+public:
+    /// <summary>Number of hash keys (buckets) in deletes.</summary>
+    size_t buckets = 0;
+    /// <summary>Number of distinct delete strings behind those keys.</summary>
+    size_t deleteStrings = 0;
+    /// <summary>Buckets shared by more than one distinct delete string.</summary>
+    size_t collidingBuckets = 0;
+    /// <summary>Total number of suggestions stored in all buckets.</summary>
+    size_t entries = 0;
+    /// <summary>Entries that are in their bucket for another delete string than the bucket's most common one.</summary>
+    size_t foreignEntries = 0;
+    size_t maxBucketSize = 0;
+    size_t maxForeignEntries = 0;
+    /// <summary>[i] = number of buckets holding 2^i .. 2^(i+1)-1 entries.</summary>
+    vector<size_t> bucketSizeHistogram;
+    /// <summary>[0] = buckets without foreign entries, [i] = buckets with 2^(i-1) .. 2^i-1 foreign entries.</summary>
+    vector<size_t> foreignEntriesHistogram;
+
+    /// <summary>Fraction of buckets shared by several delete strings.</summary>
+    double CollisionRate() const { return buckets == 0 ? 0 : (double)collidingBuckets / buckets; }
+    /// <summary>Fraction of scanned bucket entries that only exist because of collisions.</summary>
+    double ForeignRate() const { return entries == 0 ? 0 : (double)foreignEntries / entries; }
+
+    void AddBucket(size_t size, size_t foreign, size_t strings);
+    std::string ToString() const;
+};
+}
+#endif // SYMSPELL_INDEXDIAGNOSTICS_H
@@ -0,0 +1,102 @@
+#ifndef SYMSPELL_LOOKUPOPTIONS_H
+#define SYMSPELL_LOOKUPOPTIONS_H
+
+#include "utils.h"
+#include <chrono>
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Maximum edit distance of a lookup as a function of the input length in code points.</summary>
+/// Short inputs have many neighbours within a large distance, mostly unrelated words, and generate
+/// most of the delete candidates; long inputs need the full distance. table[n] is the distance for
+/// inputs of n code points, and the last entry also applies to longer inputs. The result never
+/// exceeds the maxEditDistance passed to Lookup; an empty table leaves it unchanged.
+class EditDistanceByLength
+{
+public:
+    EditDistanceByLength() { }
+    /// <summary>E.g. {0, 0, 1, 1, 1, 2}: exact match up to 1 code point, distance 1 up to 4, 2 from 5 on.</summary>
+    explicit EditDistanceByLength(vector<int> table);
+
+    /// <summary>Effective maximum edit distance for input, at most maxEditDistance.</summary>
+    int For(const string& input, int maxEditDistance) const;
+    bool Empty() const { return table.empty(); }
+
+    /// <summary>Number of UTF-8 code points of s (bytes that are not continuation bytes).</summary>
+    static size_t CodePoints(const string& s);
+
+private:
+    vector<int> table;
+};
+
+/// <summary>Limits of one Lookup; 0 leaves a limit off.</summary>
+/// Lookup time is dominated by a few inputs (long words at a large edit distance, words hitting huge
+/// buckets); a budget caps their work so a caller can hold a latency objective, at the price of
+/// possibly missing the best suggestion.
+class LookupOptions
+{
+public:
+    /// <summary>Wall clock time for the lookup, in microseconds.</summary>
+    uint64_t maxMicroseconds = 0;
+    /// <summary>Edit distance computations.</summary>
+    uint64_t maxDistanceComputations = 0;
+    /// <summary>Bucket entries looked at.</summary>
+    uint64_t maxEntriesScanned = 0;
+    bool includeUnknown = false;
+    /// <summary>Lowers the maximum edit distance of short inputs before any candidate is generated.</summary>
+    EditDistanceByLength maxEditDistanceByLength;
+};
+
+/// <summary>Outcome of a Lookup with LookupOptions.</summary>
+enum class LookupStatus
+{
+    /// <summary>Every candidate was looked at: the suggestions are those of an unbounded lookup.</summary>
+    Complete,
+    /// <summary>A budget ran out: the suggestions are the best ones found until then.</summary>
+    Truncated
+};
+
+/// <summary>Remaining work of one Lookup with LookupOptions; each call spends one unit and returns false once a budget is exhausted.</summary>
+/// The clock is read at each delete candidate and every 64 bucket entries, not per entry.
+class LookupBudget
+{
+public:
+    explicit LookupBudget(const LookupOptions& options)
+        : options(options), start(options.maxMicroseconds > 0 ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) { }
+
+    bool Candidate() { return Time(); }
+    bool Entry()
+    {
+        if (options.maxEntriesScanned > 0 && ++entries > options.maxEntriesScanned) return Exhaust();
+        return (++ticks & 63) != 0 || Time();
+    }
+    bool Distance()
+    {
+        if (options.maxDistanceComputations > 0 && ++distances > options.maxDistanceComputations) return Exhaust();
+        return true;
+    }
+    bool Exhausted() const { return exhausted; }
+
+private:
+    bool Time()
+    {
+        if (options.maxMicroseconds == 0) return !exhausted;
+        if (std::chrono::steady_clock::now() - start > std::chrono::microseconds(options.maxMicroseconds)) return Exhaust();
+        return !exhausted;
+    }
+    bool Exhaust()
+    {
+        exhausted = true;
+        return false;
+    }
+
+    const LookupOptions& options;
+    std::chrono::steady_clock::time_point start;
+    uint64_t entries = 0;
+    uint64_t distances = 0;
+    uint64_t ticks = 0;
+    bool exhausted = false;
+};
+}
+#endif // SYMSPELL_LOOKUPOPTIONS_H
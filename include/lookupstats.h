@@ -0,0 +1,74 @@
+#ifndef SYMSPELL_LOOKUPSTATS_H
+#define SYMSPELL_LOOKUPSTATS_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+
+/*
+ * Work counters of Lookup and WordSegmentation.
+ * Counting is compiled in only when the library is built with SYMSPELL_STATS
+ * (cmake -DSYMSPELL_ENABLE_STATS=ON); otherwise every SYMSPELL_STAT_ADD is empty,
+ * no counters are built or copied (a LookupStats passed to Lookup is not written)
+ * and the registry snapshot is empty.
+ */
+#ifdef SYMSPELL_STATS
+#define SYMSPELL_STAT_ADD(counters, field, n) ((counters).field += (n))
+#else
+#define SYMSPELL_STAT_ADD(counters, field, n) ((void)(counters))
+#endif
+
+class LookupStats
+{
+public:
+    /// <summary>Lookup calls aggregated in these counters.</summary>
+    uint64_t lookups = 0;
+    /// <summary>Delete candidates derived from the input (including the input prefix itself).</summary>
+    uint64_t candidatesGenerated = 0;
+    /// <summary>Probes of the deletes table, and probes that found a bucket.</summary>
+    uint64_t bucketsProbed = 0;
+    uint64_t bucketsHit = 0;
+    /// <summary>Candidates the delete filter ruled out without a probe; bucketsProbed - bucketsHit are its false positives.</summary>
+    uint64_t filterRejected = 0;
+    /// <summary>Bucket entries looked at.</summary>
+    uint64_t entriesScanned = 0;
+    /// <summary>Entries of sorted buckets passed over without a look: outside the admissible lengths, or unable to beat the Top suggestion.</summary>
+    uint64_t entriesSkipped = 0;
+    /// <summary>Entries rejected by each filter, in the order Lookup applies them.</summary>
+    uint64_t rejectedExact = 0;
+    uint64_t rejectedLength = 0;
+    uint64_t rejectedCollision = 0;
+    uint64_t rejectedPrefixLength = 0;
+    uint64_t rejectedSuffix = 0;
+    uint64_t rejectedDeleteInPrefix = 0;
+    uint64_t rejectedDuplicate = 0;
+    uint64_t rejectedDistance = 0;
+    /// <summary>Edit distance computations.</summary>
+    uint64_t distanceComputations = 0;
+    /// <summary>Lookups that returned before, or stopped the candidate loop before, exhausting all candidates.</summary>
+    uint64_t earlyExits = 0;
+    /// <summary>Lookups with LookupOptions stopped by a budget.</summary>
+    uint64_t truncated = 0;
+    /// <summary>WordSegmentation calls, and the parts they looked up.</summary>
+    uint64_t segmentations = 0;
+    uint64_t segmentationParts = 0;
+
+    LookupStats& operator+=(const LookupStats& other);
+    LookupStats operator-(const LookupStats& other) const;
+    std::string ToString() const;
+};
+
+/// <summary>Process wide accumulation of LookupStats.</summary>
+/// Every thread adds to its own slot with relaxed atomic stores (no locked instructions on the
+/// lookup path); Snapshot sums all live slots plus the slots of threads that already exited.
+class LookupStatsRegistry
+{
+public:
+    /// <summary>True if the library was built with SYMSPELL_STATS.</summary>
+    static bool Enabled();
+    static void Accumulate(const LookupStats& stats);
+    static LookupStats Snapshot();
+};
+}
+#endif // SYMSPELL_LOOKUPSTATS_H
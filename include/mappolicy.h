@@ -0,0 +1,129 @@
+#ifndef SYMSPELL_MAPPOLICY_H
+#define SYMSPELL_MAPPOLICY_H
+
+#include "utils.h"
+#include "flatmap.h"
+#include "memoryusage.h"
+#include "arena.h"
+#include <scoped_allocator>
+
+using namespace std;
+
+namespace symspell {
+
+    /// <summary>Hash containers from CUSTOM_MAP / CUSTOM_SET (std::unordered_map unless overridden).</summary>
+    struct StdMapPolicy
+    {
+        template <typename K, typename V, typename H = std::hash<K>>
+        using Map = CUSTOM_MAP<K, V, H>;
+
+        template <typename K, typename H = std::hash<K>>
+        using Set = CUSTOM_SET<K, H>;
+
+        /// <summary>Suggestion strings of a deletes bucket, and the bucket.</summary>
+        typedef string String;
+        typedef vector<string> Bucket;
+        template <typename T>
+        using Allocator = std::allocator<T>;
+        static const bool usesArena = false;
+
+        static const char* Name() { return "unordered_map"; }
+
+        /// <summary>Empty map, copy of s and allocator; the policies without an arena ignore it.</summary>
+        template <typename Table>
+        static Table MakeTable(MonotonicArena*) { return Table(); }
+        static String MakeString(const string& s, MonotonicArena*) { return s; }
+        template <typename T>
+        static Allocator<T> MakeAllocator(MonotonicArena*) { return Allocator<T>(); }
+
+        /// <summary>Bytes of the table structure, excluding heap memory owned by keys and values.</summary>
+        template <typename Table>
+        static size_t TableBytes(const Table& table) { return memory::NodeTableBytes(table); }
+        static size_t BucketBytes(const Bucket& bucket) { return memory::VectorHeapBytes(bucket); }
+        static size_t StringBytes(const String& s) { return memory::StringHeapBytes(s); }
+    };
+
+    /// <summary>Bundled cache friendly open addressing containers (see flatmap.h).</summary>
+    struct FlatMapPolicy
+    {
+        template <typename K, typename V, typename H = std::hash<K>>
+        using Map = FlatHashMap<K, V, H>;
+
+        template <typename K, typename H = std::hash<K>>
+        using Set = FlatHashSet<K, H>;
+
+        typedef string String;
+        typedef vector<string> Bucket;
+        template <typename T>
+        using Allocator = std::allocator<T>;
+        static const bool usesArena = false;
+
+        static const char* Name() { return "flat_map"; }
+
+        template <typename Table>
+        static Table MakeTable(MonotonicArena*) { return Table(); }
+        static String MakeString(const string& s, MonotonicArena*) { return s; }
+        template <typename T>
+        static Allocator<T> MakeAllocator(MonotonicArena*) { return Allocator<T>(); }
+
+        template <typename Table>
+        static size_t TableBytes(const Table& table) { return memory::MallocBytes(table.memory_usage()); }
+        static size_t BucketBytes(const Bucket& bucket) { return memory::VectorHeapBytes(bucket); }
+        static size_t StringBytes(const String& s) { return memory::StringHeapBytes(s); }
+    };
+
+    /// <summary>Dictionary tables, deletes buckets and their suggestion strings in a MonotonicArena (see arena.h).</summary>
+    /// BasicSymSpell&lt;ArenaMapPolicy&gt; and BasicSuggestionStage&lt;ArenaMapPolicy&gt; take the arena as a
+    /// constructor argument. Maps are std::unordered_map with a scoped arena allocator, so the nodes, the
+    /// bucket arrays, the Bucket vectors inside the nodes and the String elements of those vectors all come
+    /// from the arena; releasing the arena after destroying the index frees them in a few block unmaps.
+    /// Sets stay on the heap: they are the lookup and insertion scratch, cleared and refilled all the time,
+    /// which a monotonic arena would never reclaim. Word keys stay std::string (they are looked up by
+    /// std::string everywhere); CompactTerms moves them into a FrontCodedTermStore.
+    struct ArenaMapPolicy
+    {
+        template <typename T>
+        using Allocator = std::scoped_allocator_adaptor<ArenaAllocator<T>>;
+
+        template <typename K, typename V, typename H = std::hash<K>>
+        using Map = unordered_map<K, V, H, std::equal_to<K>, Allocator<pair<const K, V>>>;
+
+        template <typename K, typename H = std::hash<K>>
+        using Set = CUSTOM_SET<K, H>;
+
+        typedef basic_string<char, std::char_traits<char>, ArenaAllocator<char>> String;
+        typedef vector<String, Allocator<String>> Bucket;
+        static const bool usesArena = true;
+
+        static const char* Name() { return "arena"; }
+
+        template <typename Table>
+        static Table MakeTable(MonotonicArena* arena) { return Table(typename Table::allocator_type(ArenaAllocator<char>(arena))); }
+        static String MakeString(const string& s, MonotonicArena* arena) { return String(s.data(), s.size(), ArenaAllocator<char>(arena)); }
+        template <typename T>
+        static Allocator<T> MakeAllocator(MonotonicArena* arena) { return Allocator<T>(ArenaAllocator<T>(arena)); }
+
+        /// <summary>Bucket array plus nodes, without malloc headers and rounding.</summary>
+        template <typename Table>
+        static size_t TableBytes(const Table& table)
+        {
+            size_t node = sizeof(void*) + sizeof(typename Table::value_type) + (std::is_integral<typename Table::key_type>::value ? 0 : sizeof(size_t));
+            return table.bucket_count() * sizeof(void*) + table.size() * ((node + 7) & ~(size_t)7);
+        }
+        static size_t BucketBytes(const Bucket& bucket) { return bucket.capacity() * sizeof(String); }
+        static size_t StringBytes(const String& s) { return s.capacity() > 15 ? s.capacity() + 1 : 0; }
+    };
+
+    /// <summary>s as a std::string: s itself, or a copy in scratch for strings of another allocator.</summary>
+    inline const string& AsStdString(const string& s, string&) { return s; }
+    template <typename Allocator>
+    inline const string& AsStdString(const basic_string<char, std::char_traits<char>, Allocator>& s, string& scratch)
+    {
+        scratch.assign(s.data(), s.size());
+        return scratch;
+    }
+
+    typedef StdMapPolicy DefaultMapPolicy;
+}
+
+#endif // SYMSPELL_MAPPOLICY_H
@@ -0,0 +1,76 @@
+#ifndef SYMSPELL_MEMORYUSAGE_H
+#define SYMSPELL_MEMORYUSAGE_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Estimated heap bytes held by each structure of a dictionary.</summary>
+/// Sizes are computed from container sizes and capacities, with allocations rounded the way
+/// glibc malloc does (16 byte granularity, 8 byte header, 32 byte minimum chunk).
+class MemoryUsage
+{
+public:
+    /// <summary>words: hash table plus heap part of the keys.</summary>
+    size_t wordsBytes = 0;
+    /// <summary>belowThresholdWords: hash table plus heap part of the keys.</summary>
+    size_t belowThresholdWordsBytes = 0;
+    /// <summary>deletes: hash table structure (buckets / slots / nodes), bucket vectors excluded.</summary>
+    size_t deletesTableBytes = 0;
+    /// <summary>Arrays of the bucket vectors (sizeof(string) per reserved entry).</summary>
+    size_t bucketVectorsBytes = 0;
+    /// <summary>Heap part of the suggestion strings duplicated into the buckets (strings beyond the small string buffer).</summary>
+    size_t suggestionStringsBytes = 0;
+    /// <summary>Dictionary insertion scratch set, plus the SuggestionStage passed to MemoryUsage, if any.</summary>
+    size_t stagingBytes = 0;
+    /// <summary>Prefix completion index, once built.</summary>
+    size_t prefixIndexBytes = 0;
+    /// <summary>Filter in front of deletes, once built.</summary>
+    size_t deleteFilterBytes = 0;
+    /// <summary>Frozen words table (pilots and slots), once built.</summary>
+    size_t frozenWordsBytes = 0;
+    /// <summary>Front coded term store that replaces words after CompactTerms.</summary>
+    size_t termStoreBytes = 0;
+
+    size_t buckets = 0;
+    size_t entries = 0;
+    size_t maxBucketLength = 0;
+
+    double AverageBucketLength() const { return buckets == 0 ? 0 : (double)entries / buckets; }
+    size_t TotalBytes() const { return wordsBytes + belowThresholdWordsBytes + deletesTableBytes + bucketVectorsBytes + suggestionStringsBytes + stagingBytes + prefixIndexBytes + deleteFilterBytes + frozenWordsBytes + termStoreBytes; }
+    std::string ToString() const;
+};
+
+namespace memory {
+    /// <summary>Bytes malloc really consumes for a request of n bytes.</summary>
+    inline size_t MallocBytes(size_t n)
+    {
+        if (n == 0) return 0;
+        return max((size_t)32, (n + 8 + 15) & ~(size_t)15);
+    }
+
+    /// <summary>Heap bytes of a string, 0 while it fits the small string buffer.</summary>
+    inline size_t StringHeapBytes(const string& s)
+    {
+        return s.capacity() > 15 ? MallocBytes(s.capacity() + 1) : 0;
+    }
+
+    template <typename T>
+    inline size_t VectorHeapBytes(const vector<T>& v)
+    {
+        return MallocBytes(v.capacity() * sizeof(T));
+    }
+
+    /// <summary>Node based hash table (std::unordered_map / unordered_set): bucket array plus one node per element.</summary>
+    template <typename Table>
+    inline size_t NodeTableBytes(const Table& table)
+    {
+        typedef typename Table::key_type Key;
+        // libstdc++ caches the hash in the node unless hashing the key is trivially cheap
+        size_t node = sizeof(void*) + sizeof(typename Table::value_type) + (std::is_integral<Key>::value ? 0 : sizeof(size_t));
+        return MallocBytes(table.bucket_count() * sizeof(void*)) + table.size() * MallocBytes(node);
+    }
+}
+}
+#endif // SYMSPELL_MEMORYUSAGE_H
@@ -0,0 +1,42 @@
+#ifndef SYMSPELL_NORMALIZER_H
+#define SYMSPELL_NORMALIZER_H
+
+#include "utils.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Table driven case and diacritic folding of UTF-8 strings.</summary>
+/// Covers ASCII, Latin-1 and Latin Extended-A (U+0000 .. U+017F): 'É' folds to "e", 'ß' to "ss",
+/// 'Œ' to "oe". Other code points are copied unchanged. Folding is done once per dictionary
+/// word and once per query, so the distance kernels compare plain bytes.
+class Normalizer
+{
+public:
+    /// <summary>Bit flags selecting what is folded.</summary>
+    enum Folding
+    {
+        None = 0,
+        Case = 1,
+        Diacritics = 2,
+        CaseAndDiacritics = Case | Diacritics
+    };
+
+    Normalizer(int folding = None);
+
+    int GetFolding() const { return folding; }
+    bool Enabled() const { return folding != None; }
+
+    /// <summary>Appends the folded form of input to output.</summary>
+    void Fold(const string& input, string& output) const;
+    string Fold(const string& input) const;
+
+private:
+    int folding;
+    // folded form of each single byte code point
+    char ascii[128];
+    // folded UTF-8 of U+0080 .. U+017F
+    vector<string> latin;
+};
+}
+#endif // SYMSPELL_NORMALIZER_H
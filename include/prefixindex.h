@@ -0,0 +1,57 @@
+#ifndef SYMSPELL_PREFIXINDEX_H
+#define SYMSPELL_PREFIXINDEX_H
+
+#include "utils.h"
+#include "suggestitem.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Frequency ranked prefix completion over a sorted term array.</summary>
+/// Terms are sorted and packed into one character buffer, so all completions of a prefix are one
+/// contiguous range found by binary search. A sparse table of per block count maxima answers
+/// "most frequent term in a range" in constant time, and Complete pulls the top k out of the range
+/// with a small heap of sub ranges: O(log n + k log k), independent of the size of the range.
+class PrefixIndex
+{
+public:
+    void Clear();
+    void Add(const string& term, long count);
+    /// <summary>Sorts the added terms and builds the range maximum table. Must be called before any query.</summary>
+    void Build();
+
+    size_t Size() const { return counts.size(); }
+    string Term(size_t id) const { return text.substr(offsets[id], offsets[id + 1] - offsets[id]); }
+    size_t TermLength(size_t id) const { return offsets[id + 1] - offsets[id]; }
+    /// <summary>Byte at position of term id, or -1 past its end.</summary>
+    int CharAt(size_t id, size_t position) const { return position < TermLength(id) ? (unsigned char)text[offsets[id] + position] : -1; }
+    long Count(size_t id) const { return counts[id]; }
+
+    /// <summary>Range [first, second) of the terms starting with prefix.</summary>
+    pair<size_t, size_t> Range(const string& prefix) const;
+    /// <summary>Sub range of [lo, hi), whose terms share a prefix of length depth, that continues with byte c.</summary>
+    pair<size_t, size_t> Narrow(size_t lo, size_t hi, size_t depth, unsigned char c) const;
+    /// <summary>Ids of the k most frequent terms of [lo, hi), by descending count.</summary>
+    void TopK(size_t lo, size_t hi, size_t k, vector<size_t>& ids) const;
+
+    /// <summary>The k most frequent terms starting with prefix (distance 0), by descending count.</summary>
+    void Complete(const string& prefix, size_t k, vector<std::unique_ptr<symspell::SuggestItem>>& items) const;
+
+    size_t MemoryUsage() const;
+
+private:
+    static const size_t BlockShift = 4;
+    static const size_t BlockSize = 1 << BlockShift;
+
+    size_t Better(size_t a, size_t b) const { return counts[b] > counts[a] ? b : a; }
+    size_t ArgMax(size_t lo, size_t hi) const;
+    int ComparePrefix(size_t id, const string& prefix) const;
+
+    string text;
+    vector<uint32_t> offsets;
+    vector<long> counts;
+    // sparse[j][b] = id of the most frequent term in blocks b .. b + 2^j - 1
+    vector<vector<uint32_t>> sparse;
+};
+}
+#endif // SYMSPELL_PREFIXINDEX_H
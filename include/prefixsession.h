@@ -0,0 +1,57 @@
+#ifndef SYMSPELL_PREFIXSESSION_H
+#define SYMSPELL_PREFIXSESSION_H
+
+#include "utils.h"
+#include "prefixindex.h"
+#include "suggestitem.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>Typo tolerant typeahead state for one input field.</summary>
+/// The sorted term array of PrefixIndex is walked as an implicit trie (a node is the range of terms
+/// sharing a prefix). The session keeps, for every typed length, the set of active nodes: the
+/// prefixes within maxEditDistance of the input so far. Appending one character derives the next
+/// set from the previous one only (incremental fuzzy prefix search), so the cost per keystroke does
+/// not grow with the input length; backspace pops back to a stored set.
+class PrefixSession
+{
+public:
+    PrefixSession(const PrefixIndex& index, int maxEditDistance);
+
+    /// <summary>Moves the session to input, reusing the state of the longest common prefix with the previous input.</summary>
+    void Update(const string& input);
+    void Push(char c);
+    void Pop();
+    void Reset();
+
+    const string& Input() const { return input; }
+    size_t ActiveNodes() const { return levels.back().size(); }
+
+    /// <summary>The k best words whose prefix is within maxEditDistance of the input,
+    /// ordered by prefix edit distance, then by descending count.</summary>
+    void Suggestions(size_t k, vector<std::unique_ptr<symspell::SuggestItem>>& items) const;
+
+private:
+    struct ActiveNode
+    {
+        uint32_t lo;
+        uint32_t hi;
+        uint32_t depth;
+        uint32_t distance;
+    };
+    typedef vector<ActiveNode> ActiveSet;
+
+    ActiveNode Child(const ActiveNode& node, uint32_t at, int childChar, uint32_t distance) const;
+    void AddChildren(const ActiveNode& node, uint32_t distance, ActiveSet& next) const;
+    void MatchBelow(const ActiveNode& node, uint32_t distance, int budget, unsigned char c, ActiveSet& next) const;
+    static void Compact(ActiveSet& set);
+
+    const PrefixIndex* index;
+    int maxEditDistance;
+    string input;
+    // levels[i] = active nodes after i typed characters
+    vector<ActiveSet> levels;
+};
+}
+#endif // SYMSPELL_PREFIXSESSION_H
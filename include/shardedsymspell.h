@@ -0,0 +1,83 @@
+#ifndef SYMSPELL_SHARDEDSYMSPELL_H
+#define SYMSPELL_SHARDEDSYMSPELL_H
+
+#include "symspell.h"
+using namespace std;
+
+namespace symspell {
+
+/// <summary>One partition of a sharded dictionary.</summary>
+/// A lookup is split in Start and Finish so that shards living in other processes all work on
+/// the query at the same time: the coordinator starts every shard, then collects the results.
+class Shard
+{
+public:
+    virtual ~Shard() { }
+
+    virtual void Start(const string& input, Verbosity verbosity, int maxEditDistance) = 0;
+    /// <summary>Suggestions of the lookup begun by Start, in Lookup order.</summary>
+    virtual void Finish(vector<std::unique_ptr<symspell::SuggestItem>> & items) = 0;
+    /// <summary>Ends the lookup begun by Start when its result is not needed.</summary>
+    virtual void Skip() { vector<std::unique_ptr<symspell::SuggestItem>> unused; Finish(unused); }
+};
+
+/// <summary>Shard backed by a SymSpell instance in this process.</summary>
+class LocalShard : public Shard
+{
+public:
+    LocalShard(int maxDictionaryEditDistance, int prefixLength, int countThreshold)
+        : engine(defaultInitialCapacity, maxDictionaryEditDistance, prefixLength, countThreshold) { }
+
+    SymSpell& Engine() { return engine; }
+
+    void Start(const string& input, Verbosity verbosity, int maxEditDistance);
+    void Finish(vector<std::unique_ptr<symspell::SuggestItem>> & items);
+    void Skip() { }
+
+private:
+    SymSpell engine;
+    string input;
+    Verbosity verbosity = Verbosity::Top;
+    int maxEditDistance = 0;
+};
+
+/// <summary>Dictionary split into K shards by word hash, each with its own deletes index.</summary>
+/// Lookup asks every shard and merges the partial suggestion lists with the SuggestItem order and
+/// the verbosity rules, so the result is that of one unsharded index over all words: every word
+/// lives in exactly one shard, and each shard returns the best of its own words.
+/// Shards can be local (built here) or remote (e.g. symspell-server --shard i/K, see tools/).
+class ShardedSymSpell
+{
+public:
+    /// <summary>K local shards with the given index parameters.</summary>
+    ShardedSymSpell(size_t shardCount, int maxDictionaryEditDistance = defaultMaxEditDistance, int prefixLength = defaultPrefixLength, int countThreshold = defaultCountThreshold);
+    /// <summary>Coordinator over existing shards; shards[i] must hold the words with ShardOf(word, shards.size()) == i.</summary>
+    ShardedSymSpell(vector<std::unique_ptr<Shard>> shards, int maxDictionaryEditDistance);
+
+    /// <summary>Shard index of word among shardCount shards.</summary>
+    static size_t ShardOf(const string& word, size_t shardCount);
+
+    /// <summary>Reads a frequency dictionary into target, keeping only the words of one shard.</summary>
+    static bool LoadDictionaryShard(SymSpell& target, const string& corpus, int termIndex, int countIndex, size_t shard, size_t shardCount);
+
+    size_t ShardCount() const { return shards.size(); }
+    Shard& GetShard(size_t i) { return *shards[i]; }
+
+    /// <summary>Adds a word to its (local) shard.</summary>
+    bool CreateDictionaryEntry(const string& key, long count);
+    /// <summary>Reads a frequency dictionary, routing every word to its (local) shard.</summary>
+    bool LoadDictionary(const string& corpus, int termIndex, int countIndex);
+
+    void Lookup(string& input, Verbosity verbosity, vector<std::unique_ptr<symspell::SuggestItem>> & items);
+    /// <summary>Same contract as SymSpell::Lookup. Not safe to call concurrently when shards are remote.</summary>
+    void Lookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions);
+
+private:
+    LocalShard& Local(size_t shard);
+
+    vector<std::unique_ptr<Shard>> shards;
+    int maxDictionaryEditDistance;
+    vector<vector<std::unique_ptr<symspell::SuggestItem>>> partials;
+};
+}
+#endif // SYMSPELL_SHARDEDSYMSPELL_H
@@ -0,0 +1,92 @@
+#ifndef SYMSPELL_STREAMINGSEGMENTER_H
+#define SYMSPELL_STREAMINGSEGMENTER_H
+
+#include "symspell.h"
+
+using namespace std;
+
+namespace symspell {
+#define defaultMaxPendingLength 4096
+
+/// <summary>Word segmentation of text arriving in chunks, with output as soon as it is decided.</summary>
+/// Runs the dynamic program of WordSegmentation, but a composition is a node holding its last word and
+/// a pointer to the composition it extends, instead of whole strings. Only the compositions ending in
+/// the next maxSegmentationWordLength positions can still be extended; once all of them descend from
+/// the same node, the words up to that node are final and are emitted, and the nodes before it are
+/// freed. The input is kept from the current position on only.
+///
+/// If the surviving compositions have not agreed for maxPendingLength bytes (long garbage), the best
+/// composition ending at the current position is committed anyway and the ones that do not extend it
+/// are dropped, so memory stays bounded; the result may then differ from WordSegmentation.
+/// Otherwise the output equals the segmentedString and correctedString of WordSegmentation on the whole input.
+template <typename Engine = SymSpell>
+class BasicStreamingSegmenter
+{
+public:
+    BasicStreamingSegmenter(Engine& engine, size_t maxEditDistance, size_t maxSegmentationWordLength, size_t maxPendingLength = defaultMaxPendingLength);
+    explicit BasicStreamingSegmenter(Engine& engine) : BasicStreamingSegmenter(engine, engine.MaxDictionaryEditDistance(), engine.MaxLength()) { }
+
+    /// <summary>Appends chunk to the input and segments as far as the input allows.</summary>
+    void Feed(const string& chunk);
+    /// <summary>Ends the input: the rest is segmented and emitted, and the next Feed starts a new text.</summary>
+    void Finish();
+    /// <summary>Discards the input and the output not taken yet.</summary>
+    void Reset();
+
+    /// <summary>Segmented (spaces inserted) and corrected text emitted since the last call; the two are taken together.</summary>
+    void Take(string& segmented, string& corrected);
+    /// <summary>Input bytes read but not emitted yet.</summary>
+    size_t PendingLength() const { return offset + text.size() - committed->end; }
+    /// <summary>Edit distance sum and log10 probability sum of the words emitted for the current text.</summary>
+    long DistanceSum() const { return committed->distanceSum; }
+    double ProbabilityLogSum() const { return committed->probabilityLogSum; }
+    /// <summary>Work counters since construction or Reset.</summary>
+    const LookupStats& Stats() const { return counters; }
+
+private:
+    struct Node
+    {
+        shared_ptr<Node> parent;
+        // input position after the word
+        size_t end = 0;
+        string segmented;
+        string corrected;
+        long distanceSum = 0;
+        double probabilityLogSum = 0;
+    };
+
+    void StartText();
+    /// <summary>Extends the composition ending at position by every part starting there.</summary>
+    void Step();
+    /// <summary>Emits the words up to the last node shared by all compositions that can still be extended.</summary>
+    void Commit();
+    /// <summary>Emits the words of node's composition after committed, and makes node the committed one.</summary>
+    void Emit(const shared_ptr<Node>& node);
+    shared_ptr<Node>& Slot(size_t end) { return window[end % window.size()]; }
+
+    Engine* engine;
+    size_t maxEditDistance;
+    size_t maxPendingLength;
+
+    // input from offset on; position is the next start of a part
+    string text;
+    size_t offset = 0;
+    size_t position = 0;
+    // compositions ending at position .. position + maxSegmentationWordLength, by end modulo the size
+    vector<shared_ptr<Node>> window;
+    // last node emitted; the root of every composition still in the window
+    shared_ptr<Node> committed;
+    bool emitted = false;
+    bool finished = false;
+    // counters.segmentationParts when the text started
+    uint64_t textParts = 0;
+
+    string segmentedOut;
+    string correctedOut;
+    LookupStats counters;
+};
+
+typedef BasicStreamingSegmenter<> StreamingSegmenter;
+}
+
+#endif // SYMSPELL_STREAMINGSEGMENTER_H
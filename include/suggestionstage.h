@@ -3,26 +3,41 @@
 
 #include "utils.h"
 # include "chunkarray.h"
+#include "mappolicy.h"
 
 using namespace std;
 
 namespace symspell {
 
-class SuggestionStage
+/// <summary>Deletes of many dictionary entries collected before they are added to the deletes map in one pass.</summary>
+/// With ArenaMapPolicy the entries, the node chunks and the suggestions are allocated from arena.
+template <typename MapPolicy = DefaultMapPolicy>
+class BasicSuggestionStage
 {
 public:
-    unordered_map<size_t, Entry> Deletes;
-    unordered_map<size_t, Entry>::iterator DeletesEnd;
+    typedef typename MapPolicy::template Map<size_t, Entry> EntryMap;
+    typedef typename MapPolicy::template Map<size_t, typename MapPolicy::Bucket> DeletesMap;
+    typedef BasicNode<typename MapPolicy::String> StageNode;
 
-    ChunkArray<Node> Nodes;
-    SuggestionStage(size_t initialCapacity);
+    EntryMap Deletes;
+    typename EntryMap::iterator DeletesEnd;
+
+    ChunkArray<StageNode, typename MapPolicy::template Allocator<StageNode>> Nodes;
+    BasicSuggestionStage(size_t initialCapacity, MonotonicArena* arena = nullptr);
     size_t DeleteCount() { return Deletes.size(); }
     size_t NodeCount() { return Nodes.Count; }
+    /// <summary>Estimated heap bytes of the staged deletes and nodes.</summary>
+    size_t MemoryUsage();
     void Clear();
     void Add(size_t deleteHash, string suggestion);
-    void CommitTo(unordered_map<size_t, vector<string>> & permanentDeletes);
+    void CommitTo(DeletesMap & permanentDeletes);
+
+private:
+    MonotonicArena* arena;
 
 };
+
+typedef BasicSuggestionStage<> SuggestionStage;
 }
 
 #endif  // SYMSPELL_SUGGESTIONSTAGE_H
@@ -25,6 +25,7 @@ public:
 
     ~SuggestItem();
 
+    /// <summary>True if this item sorts after other: by distance ascending, then count descending, then term.</summary>
     bool CompareTo(SuggestItem const& other);
 
     bool operator == (const SuggestItem &ref) const;
@@ -7,6 +7,19 @@
 #include "suggestionstage.h"
 #include "wordsegmentationitem.h"
 #include "editdistance.h"
+#include "mappolicy.h"
+#include "indexdiagnostics.h"
+#include "lookupstats.h"
+#include "lookupoptions.h"
+#include "memoryusage.h"
+#include "prefixindex.h"
+#include "prefixsession.h"
+#include "normalizer.h"
+#include "deletefilter.h"
+#include "frozenwordtable.h"
+#include "frontcodedtermstore.h"
+#include "corpuscounter.h"
+#include "distancepolicy.h"
 
 
 
@@ -16,23 +29,51 @@ using namespace std;
 
 namespace symspell {
 
-    class SymSpell {
+    /// <summary>Symmetric delete spelling correction engine.</summary>
+    /// MapPolicy selects the hash containers backing words, deletes and the lookup scratch sets
+    /// (see mappolicy.h); StdMapPolicy, FlatMapPolicy and ArenaMapPolicy are instantiated in symspell.cpp.
+    /// ArenaMapPolicy needs the arena as the last constructor argument, and the arena must outlive the engine.
+    template <typename MapPolicy = DefaultMapPolicy>
+    class BasicSymSpell {
     public:
-        SymSpell(int initialCapacity = defaultInitialCapacity, int maxDictionaryEditDistance = defaultMaxEditDistance, int prefixLength = defaultPrefixLength, int countThreshold = defaultCountThreshold, int compactLevel = defaultCompactLevel);
-        ~SymSpell();
-        bool CreateDictionaryEntry(string key, long count, SuggestionStage * staging = nullptr);
-        void EditsPrefix(string key, unordered_set<size_t>& hashSet);
-        void Edits(string word, int editDistance, unordered_set<size_t> & deleteWords);
+        typedef typename MapPolicy::template Set<size_t> HashSet;
+        typedef typename MapPolicy::Bucket Bucket;
+        typedef typename MapPolicy::template Map<size_t, Bucket> DeletesMap;
+        typedef typename MapPolicy::template Map<string, long> WordsMap;
+        typedef typename MapPolicy::template Map<string, pair<string, long>> SurfaceMap;
+        typedef BasicSuggestionStage<MapPolicy> Stage;
+
+        BasicSymSpell(int initialCapacity = defaultInitialCapacity, int maxDictionaryEditDistance = defaultMaxEditDistance, int prefixLength = defaultPrefixLength, int countThreshold = defaultCountThreshold, int compactLevel = defaultCompactLevel, MonotonicArena* arena = nullptr);
+        ~BasicSymSpell();
+        bool CreateDictionaryEntry(string key, long count, Stage * staging = nullptr);
+        void EditsPrefix(string key, HashSet& hashSet);
+        void Edits(string word, int editDistance, HashSet & deleteWords);
         void PurgeBelowThresholdWords();
-        void CommitStaged(SuggestionStage staging);
+        void CommitStaged(Stage staging);
         void Lookup(string& input, Verbosity verbosity, vector<std::unique_ptr<symspell::SuggestItem>> & items);
         void Lookup(string& input, Verbosity verbosity, int maxEditDistance, vector<std::unique_ptr<symspell::SuggestItem>> & items);
-        void Lookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions);
+        /// <summary>Finds suggestions for input; stats, if given, receives the work counters of this call in SYMSPELL_STATS builds (see lookupstats.h).</summary>
+        /// Lookups may run concurrently from several threads, as long as no words are added meanwhile.
+        /// With includeUnknown, an input without any suggestion comes back as the only item, at distance maxEditDistance + 1 with count 0.
+        void Lookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats* stats = nullptr);
+        /// <summary>Lookup within the budgets of options (see lookupoptions.h).</summary>
+        /// When a budget runs out the lookup stops and returns Truncated, with the best suggestions found so far.
+        /// options.maxEditDistanceByLength lowers maxEditDistance for short inputs.
+        LookupStatus Lookup(string& input, Verbosity verbosity, int maxEditDistance, const LookupOptions& options, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats* stats = nullptr);
         bool LoadDictionary(string corpus, int termIndex, int countIndex);
+        /// <summary>Adds the words of raw text files with their counts, counted by threads threads (see corpuscounter.h); false if a file cannot be read.</summary>
+        /// With sketchWidth > 0 a count-min sketch of that width keeps words that cannot reach countThreshold
+        /// out of the exact counts, so they never reach belowThresholdWords either.
+        bool BuildFromCorpus(const vector<string>& paths, size_t threads = 1, size_t sketchWidth = 0);
         void rempaceSpaces(string& source);
         shared_ptr<WordSegmentationItem> WordSegmentation(string& input);
         shared_ptr<WordSegmentationItem> WordSegmentation(string& input, size_t maxEditDistance);
-        shared_ptr<WordSegmentationItem> WordSegmentation(string& input, size_t maxEditDistance, size_t maxSegmentationWordLength);
+        shared_ptr<WordSegmentationItem> WordSegmentation(string& input, size_t maxEditDistance, size_t maxSegmentationWordLength, LookupStats* stats = nullptr);
+        /// <summary>Scores part (input text starting at a candidate word boundary) as one word of a segmentation; returns its edit distance.</summary>
+        /// A leading space is dropped, otherwise separatorLength is 1 (a space had to be inserted); the other
+        /// spaces are removed and count as edits. corrected receives the best suggestion, or part if there is
+        /// none, and probabilityLog its log10 probability. Shared by WordSegmentation and StreamingSegmenter.
+        int SegmentationPart(string& part, size_t maxEditDistance, int& separatorLength, string& corrected, double& probabilityLog, LookupStats& counters);
         /// <summary>Maximum edit distance for dictionary precalculation.</summary>
         size_t MaxDictionaryEditDistance() { return this->maxDictionaryEditDistance; }
 
@@ -46,45 +87,215 @@ namespace symspell {
         long CountThreshold() { return this->countThreshold; }
 
         /// <summary>Number of unique words in the dictionary.</summary>
-        size_t WordCount() { return this->words.size(); }
+        size_t WordCount() { return termsCompacted ? this->terms.Size() : this->words.size(); }
 
         /// <summary>Number of word prefixes and intermediate word deletes encoded in the dictionary.</summary>
         size_t EntryCount() { return this->deletes.size(); }
         
-        inline void setDistanceAlgorithm(EditDistance::DistanceAlgorithm ed) {this->distanceComparer = new EditDistance(ed);} 
+        inline void setDistanceAlgorithm(EditDistance::DistanceAlgorithm ed)
+        {
+            delete this->distanceComparer;
+            this->distanceComparer = new EditDistance(ed);
+            this->distanceAlgorithm = ed;
+            SelectKernel();
+        }
+        /// <summary>Lets Lookup and dictionary building use the compile time specialized kernel of the current parameters, if there is one (the default; see SymSpellT).</summary>
+        void EnableFixedKernels(bool enable)
+        {
+            fixedKernels = enable;
+            SelectKernel();
+        }
+        /// <summary>True if lookups run on a compile time specialized kernel.</summary>
+        bool UsesFixedKernel() const { return editsFunction != nullptr; }
+
+        /// <summary>Case and diacritic folding applied to dictionary words and queries; can only be changed while the dictionary is empty.</summary>
+        /// Suggestions are returned in the most frequent original spelling of each folded word.
+        void setNormalizer(const Normalizer& normalizer);
+
+        /// <summary>Seed of the delete hash; can only be changed while the index is empty.</summary>
+        void setHashSeed(uint64_t seed);
+
+        /// <summary>Collision rate, bucket size histogram and foreign entries of the deletes index.</summary>
+        /// Regenerates the delete strings of every word, so it costs about as much as rebuilding the index.
+        IndexDiagnostics DiagnoseIndex();
+
+        /// <summary>Estimated bytes held by words, belowThresholdWords, deletes and its buckets, and staging structures.</summary>
+        symspell::MemoryUsage MemoryUsage(Stage* staging = nullptr);
+
+        /// <summary>Builds what Lookup uses on a complete dictionary: delete filter, frozen words and sorted buckets.</summary>
+        /// LoadDictionary calls it; call it after adding words with CreateDictionaryEntry or CommitStaged.
+        void FinishLoading();
+        /// <summary>Orders every deletes bucket by suggestion length, then by descending count, then by term.</summary>
+        /// Lookup then starts at the first admissible length, stops past the last one, and under Top skips the
+        /// rest of a length once its entries can no longer replace the best suggestion. Adding words drops the order.
+        void SortBuckets();
+
+        /// <summary>(Re)builds the filter Lookup checks before probing deletes, sized for the current deletes (see deletefilter.h).</summary>
+        /// FinishLoading builds it; words added later go into the filter too, and it is rebuilt once it holds twice its size.
+        void BuildDeleteFilter(double bitsPerKey = defaultFilterBitsPerKey);
+        /// <summary>Drops the delete filter; Lookup then probes deletes for every candidate.</summary>
+        void DropDeleteFilter() { deleteFilter.Clear(); }
+        /// <summary>Size of the delete filter, with its false positive rate measured on samples random hashes absent from deletes.</summary>
+        DeleteFilterReport DiagnoseDeleteFilter(size_t samples = 1000000);
+
+        /// <summary>Builds the minimal perfect hash table of the words and their counts (see frozenwordtable.h).</summary>
+        /// FinishLoading builds it; adding words drops it until the next call. While it exists, Lookup
+        /// and IsKnown take counts from it instead of probing words.
+        void FreezeWords();
+        /// <summary>Makes the frozen table keep 16 bit log-quantized counts (see countquantizer.h), rebuilding it if it exists.</summary>
+        /// Its slots shrink from 16 to 8 bytes. Lookup, IsKnown and WordSegmentation then see counts
+        /// rounded to within CountQuantizer::Step(), which keeps the ranking of counts further apart than that.
+        /// Quantizing is one way after CompactTerms: the exact counts are gone, so QuantizeCounts(false) throws logic_error.
+        void QuantizeCounts(bool enable = true);
+        /// <summary>True if word (folded by the normalizer) is a dictionary word; count, if given, receives its count.</summary>
+        bool IsKnown(const string& word, long* count = nullptr);
+        /// <summary>IsKnown for every word: known[i] = 1 if words[i] is known, (*counts)[i] its count (0 if not).</summary>
+        /// With the frozen table and threads > 1, large batches are checked in parallel.
+        void IsKnownBatch(const vector<string>& words, vector<uint8_t>& known, vector<long>* counts = nullptr, size_t threads = 1);
+
+        /// <summary>Moves the words into a sorted, front coded term store and releases the words hash map.</summary>
+        /// Counts are then kept by the frozen words table alone, quantized if QuantizeCounts is on. Term ids are ranks in the store (see Terms()).
+        /// The dictionary becomes read only: CreateDictionaryEntry throws logic_error afterwards.
+        void CompactTerms(size_t blockSize = defaultTermBlockSize);
+        /// <summary>Sorted terms with their ids, filled by CompactTerms.</summary>
+        const FrontCodedTermStore& Terms() const { return terms; }
+
+        /// <summary>(Re)builds the prefix completion index from the current words; words added later need a rebuild.</summary>
+        void BuildPrefixIndex();
+
+        /// <summary>The k most frequent dictionary words starting with prefix, by descending count (see BuildPrefixIndex).</summary>
+        void Complete(const string& prefix, size_t k, vector<std::unique_ptr<symspell::SuggestItem>> & items);
+
+        /// <summary>The k best words whose prefix is within maxEditDistance of partialInput, by distance then count (see BuildPrefixIndex).</summary>
+        void LookupPrefix(const string& partialInput, int maxEditDistance, size_t k, vector<std::unique_ptr<symspell::SuggestItem>> & items);
+
+        /// <summary>Typeahead session over the prefix index; keeps its state between keystrokes (see prefixsession.h).</summary>
+        /// The session works on folded strings: its input has to be folded with the normalizer, and it suggests folded words.
+        PrefixSession CreatePrefixSession(int maxEditDistance) { return PrefixSession(prefixIndex, maxEditDistance); }
 
     private:
         int initialCapacity;
+        // tables, buckets and suggestions of ArenaMapPolicy; nullptr for the other policies
+        MonotonicArena* arena;
         int maxDictionaryEditDistance;
         int prefixLength; //prefix length  5..7
         long countThreshold; //a treshold might be specifid, when a term occurs so frequently in the corpus that it is considered a valid word for spelling correction
         uint compactMask;
         EditDistance::DistanceAlgorithm distanceAlgorithm = EditDistance::DistanceAlgorithm::DamerauOSA;
         size_t maxDictionaryWordLength; //maximum dictionary term length
-        std::mutex mtx;
 
-        vector<string> candidates;
+        // Per thread scratch of DoLookup: delete candidates, hashes of candidates and of suggestions already seen.
+        struct LookupScratch
+        {
+            vector<string> candidates;
+            HashSet hashset1;
+            HashSet hashset2;
+            // copy of a bucket suggestion when the policy's strings are not std::string
+            string suggestion;
+        };
 
         EditDistance* distanceComparer{ nullptr };
-        unordered_set<size_t> edits;
-        unordered_set<size_t> hashset1; //TODO: use unordered_set<size_t> hashset1;
-        unordered_set<size_t> hashset2; //TODO: use unordered_set<size_t> hashset1;
-        unordered_set<size_t>::iterator hashset2End;  //TODO: use unordered_set<size_t>::iterator hashset2End; 
+        HashSet edits;
         hash_c_string stringHash;
         long N = 1024908267229;
+        const double log10N = log10((double)N);
 
-        unordered_map<size_t, vector<string>> deletes;
-        unordered_map<size_t, vector<string>>::iterator deletesEnd;
+        DeletesMap deletes;
+        typename DeletesMap::iterator deletesEnd;
+        // Approximate membership of the deletes keys, checked before probing deletes.
+        DeleteFilter deleteFilter;
 
         // Dictionary of unique correct spelling words, and the frequency count for each word.
-        unordered_map<string, long> words;
-        unordered_map<string, long>::iterator wordsEnd;
+        WordsMap words;
+        typename WordsMap::iterator wordsEnd;
+
+        // Frozen copy of words, addressed by a minimal perfect hash; empty until FreezeWords.
+        FrozenWordTable knownWords;
+        bool quantizeCounts = false;
+        // Sorted copy of the words once CompactTerms released the words map.
+        FrontCodedTermStore terms;
+        bool termsCompacted = false;
+
+        // True while every deletes bucket is in SortBuckets order.
+        bool bucketsSorted = false;
 
         // Dictionary of unique words that are below the count threshold for being considered correct spellings.
-        unordered_map<string, long> belowThresholdWords;
-        unordered_map<string, long>::iterator belowThresholdWordsEnd;
+        WordsMap belowThresholdWords;
+        typename WordsMap::iterator belowThresholdWordsEnd;
+
+        // Folding of words and queries, and the original spelling (with its count) of folded words that differ from it.
+        Normalizer normalizer;
+        SurfaceMap surfaceForms;
+        typename SurfaceMap::iterator surfaceFormsEnd;
+
+        // Sorted words with range maxima of their counts, for prefix completion.
+        PrefixIndex prefixIndex;
+
+        // Candidate generation and distance of DoLookup (see symspell.cpp): RuntimeKernel follows the constructor
+        // parameters, FixedKernel has them as template arguments. SelectKernel points lookupFunction and
+        // editsFunction at the fixed kernel matching the parameters, if one is instantiated.
+        struct RuntimeKernel;
+        template <int MaxEd, int PrefixLen, typename DistancePolicy>
+        struct FixedKernel;
+        typedef void (BasicSymSpell::*LookupFunction)(string&, Verbosity, int, bool, vector<std::unique_ptr<symspell::SuggestItem>>&, LookupStats&, LookupBudget*);
+        typedef void (BasicSymSpell::*EditsFunction)(string, HashSet&);
+        LookupFunction lookupFunction;
+        EditsFunction editsFunction = nullptr;
+        bool fixedKernels = true;
+        void SelectKernel();
+        template <int MaxEd, int PrefixLen, typename DistancePolicy>
+        void UseFixedKernel();
+        template <int MaxEd, int PrefixLen>
+        void FixedEditsPrefix(string key, HashSet& hashSet);
+
+        bool FindWord(const string& word, long& count);
+        /// <summary>Calls visit(word, count) for every word, from words or, after CompactTerms, from the term store.</summary>
+        template <typename Visit>
+        void ForEachWord(Visit visit);
+        void RecordSurfaceForm(const string& key, const string& surface, long count);
+        void ToSurfaceForms(const string& input, int maxEditDistance, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions);
+        /// <summary>Lookup with an optional budget; false if the budget ran out.</summary>
+        bool BoundedLookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats* stats, LookupBudget* budget);
+        template <typename Kernel>
+        void DoLookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats& counters, LookupBudget* budget);
+        bool DeleteInSuggestionPrefix(const string& del, int deleteLen, const string& suggestion, int suggestionLen);
+        void DeleteStrings(string word, int editDistance, unordered_set<string> & deleteWords);
+    };
 
-        bool DeleteInSuggestionPrefix(string del, int deleteLen, string suggestion, int suggestionLen);
+    typedef BasicSymSpell<> SymSpell;
+
+    /// <summary>Parameter sets with a compile time specialized kernel in symspell.cpp.</summary>
+    template <int MaxEd, int PrefixLen, typename DistancePolicy>
+    struct HasFixedKernel : std::false_type { };
+    template <> struct HasFixedKernel<1, 7, OsaDistance> : std::true_type { };
+    template <> struct HasFixedKernel<2, 7, OsaDistance> : std::true_type { };
+    template <> struct HasFixedKernel<3, 7, OsaDistance> : std::true_type { };
+    template <> struct HasFixedKernel<1, 5, LevenshteinDistance> : std::true_type { };
+    template <> struct HasFixedKernel<2, 7, LevenshteinDistance> : std::true_type { };
+
+    /// <summary>SymSpell with maximum edit distance, prefix length and distance fixed at compile time.</summary>
+    /// Lookups and dictionary building always run on the specialized kernel: deletes from a precomputed
+    /// position mask table into stack buffers instead of a queue of strings and a hash set, and the distance
+    /// inlined instead of called through a function pointer. BasicSymSpell picks the same kernels at run time
+    /// when its parameters match one of the HasFixedKernel sets.
+    template <int MaxEd, int PrefixLen, typename DistancePolicy = OsaDistance, typename MapPolicy = DefaultMapPolicy>
+    class SymSpellT : public BasicSymSpell<MapPolicy>
+    {
+        static_assert(HasFixedKernel<MaxEd, PrefixLen, DistancePolicy>::value, "no fixed kernel for these parameters in symspell.cpp");
+    public:
+        static const int maxEditDistance = MaxEd;
+        static const int prefixLength = PrefixLen;
+
+        SymSpellT(int initialCapacity = defaultInitialCapacity, int countThreshold = defaultCountThreshold, MonotonicArena* arena = nullptr)
+            : BasicSymSpell<MapPolicy>(initialCapacity, MaxEd, PrefixLen, countThreshold, defaultCompactLevel, arena)
+        {
+            this->setDistanceAlgorithm(DistancePolicy::algorithm);
+        }
+
+    private:
+        // either would move lookups off the kernel the static_assert checked
+        using BasicSymSpell<MapPolicy>::EnableFixedKernels;
+        using BasicSymSpell<MapPolicy>::setDistanceAlgorithm;
     };
 }
 
@@ -67,12 +67,14 @@ namespace symspell {
         All
     };
   
-    class Node
+    template <typename String = string>
+    class BasicNode
     {
     public:
-        string suggestion;
+        String suggestion;
         long next;
     };
+    typedef BasicNode<> Node;
 
     class Entry
     {
@@ -102,18 +104,76 @@ namespace symspell {
         }
     };
 
-    struct hash_c_string {
-        void hash_combine(size_t& seed, const char& v)
+    /*
+     * Word-at-a-time 64-bit string hash (wyhash style multiply-fold mixing).
+     * Reads 8 or 16 bytes per step instead of folding one signed char at a time,
+     * and takes a seed so the index can be rebuilt with another hash family.
+     */
+#define defaultHashSeed 0x243f6a8885a308d3ULL
+
+    namespace {
+        const uint64_t hashK0 = 0xa0761d6478bd642fULL;
+        const uint64_t hashK1 = 0xe7037ed1a0b428dbULL;
+        const uint64_t hashK2 = 0x8ebc6af09c88c6e3ULL;
+
+        inline uint64_t hashMum(uint64_t a, uint64_t b)
+        {
+#ifdef __SIZEOF_INT128__
+            __uint128_t r = (__uint128_t)a * b;
+            return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+            uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+            uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            uint64_t t = rl + (rm0 << 32), c = t < rl;
+            uint64_t lo = t + (rm1 << 32); c += lo < t;
+            uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+            return lo ^ hi;
+#endif
+        }
+
+        inline uint64_t hashRead64(const char* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+        inline uint64_t hashRead32(const char* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    }
+
+    inline uint64_t hash64(const char* p, size_t len, uint64_t seed = defaultHashSeed)
+    {
+        uint64_t state = seed ^ hashK0;
+        uint64_t a, b;
+        size_t remaining = len;
+        while (remaining > 16)
         {
-            seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            state = hashMum(hashRead64(p) ^ hashK1, hashRead64(p + 8) ^ state);
+            p += 16;
+            remaining -= 16;
         }
+        if (remaining > 8)
+        {
+            a = hashRead64(p);
+            b = hashRead64(p + remaining - 8);
+        }
+        else if (remaining >= 4)
+        {
+            a = hashRead32(p);
+            b = hashRead32(p + remaining - 4);
+        }
+        else if (remaining > 0)
+        {
+            a = ((uint64_t)(unsigned char)p[0] << 16) | ((uint64_t)(unsigned char)p[remaining >> 1] << 8) | (unsigned char)p[remaining - 1];
+            b = 0;
+        }
+        else
+            a = b = 0;
+        return hashMum(hashK1 ^ len, hashMum(a ^ hashK1, b ^ state ^ hashK2));
+    }
+
+    struct hash_c_string {
+        uint64_t seed;
+
+        hash_c_string(uint64_t seed = defaultHashSeed) : seed(seed) { }
 
-        std::size_t operator() (string& p) const
+        std::size_t operator() (const string& p) const
         {
-            size_t hash = 0;
-            for (auto inc_p = p.begin(); inc_p != p.end(); inc_p++)
-                hash ^= *inc_p + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-            return hash;
+            return (size_t)hash64(p.data(), p.size(), seed);
         }
     };
 //     char* strndup(string s1, size_t n);
@@ -131,10 +191,10 @@ namespace symspell {
  * ########## BEGIN ##########
  */
 
-    int levenshtein_dist(string& word1, string& word2);
-    int dl_dist(string& word1, string& word2);
-    int dl_dist_spe(string& word1, string& word2);
-    float dl_dist_float(string& word1, string& word2);
+    int levenshtein_dist(const string& word1, const string& word2);
+    int dl_dist(const string& word1, const string& word2);
+    int dl_dist_spe(const string& word1, const string& word2);
+    float dl_dist_float(const string& word1, const string& word2);
     
 }
 
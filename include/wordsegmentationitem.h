@@ -12,7 +12,8 @@ class WordSegmentationItem
 public:
     string segmentedString;
     string correctedString;
-    u_int8_t distanceSum = 0;
+    // edits plus inserted separators; an 8-bit sum before, which wrapped at 255 on long inputs
+    long distanceSum = 0;
     double probabilityLogSum = 0;
 
     WordSegmentationItem() { }
@@ -21,7 +22,7 @@ public:
     WordSegmentationItem& operator=(const WordSegmentationItem&) { return *this; }
     WordSegmentationItem& operator=(WordSegmentationItem&&) { return *this; }
 
-    void set(string pSegmentedString, string pCorrectedString, u_int8_t pDistanceSum, double pProbabilityLogSum);
+    void set(string pSegmentedString, string pCorrectedString, long pDistanceSum, double pProbabilityLogSum);
     ~WordSegmentationItem();
 };
 }
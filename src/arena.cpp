@@ -0,0 +1,94 @@
+#include "arena.h"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace symspell {
+
+    namespace {
+        const size_t hugePageSize = 2 << 20;
+    }
+
+    MonotonicArena::MonotonicArena(size_t blockSize, HugePages hugePages)
+    {
+        if (blockSize < 4096) throw std::invalid_argument("blockSize");
+        // whole huge pages, or the tail of each block would be on regular pages
+        if (hugePages != HugePages::None) blockSize = (blockSize + hugePageSize - 1) & ~(hugePageSize - 1);
+        this->blockSize = blockSize;
+        this->hugePages = hugePages;
+    }
+
+    MonotonicArena::~MonotonicArena()
+    {
+        Release();
+    }
+
+    MonotonicArena::Block MonotonicArena::Map(size_t bytes)
+    {
+        Block block = { nullptr, bytes, false };
+#if defined(__linux__)
+        if (hugePages == HugePages::Explicit && bytes % hugePageSize == 0)
+        {
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                ++hugeTlbBlocks;
+                block.base = p;
+                block.mapped = true;
+                return block;
+            }
+        }
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+        if (hugePages != HugePages::None) madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+        block.base = p;
+        block.mapped = true;
+#else
+        block.base = ::operator new(bytes);
+#endif
+        return block;
+    }
+
+    void* MonotonicArena::AllocateSlow(size_t bytes, size_t alignment)
+    {
+        if (bytes > blockSize / 4)
+        {
+            // a large request (a hash table's bucket array) gets a block of its own and the current
+            // block stays current, instead of its rest being given up
+            size_t size = (bytes + alignment + 4095) & ~(size_t)4095;
+            if (hugePages != HugePages::None) size = (size + hugePageSize - 1) & ~(hugePageSize - 1);
+            Block block = Map(size);
+            blocks.push_back(block);
+            reserved += size;
+            usedBefore += bytes;
+            // mapped blocks are page aligned
+            return block.base;
+        }
+        usedBefore += used;
+        Block block = Map(blockSize);
+        blocks.push_back(block);
+        reserved += blockSize;
+        current = static_cast<char*>(block.base);
+        capacity = blockSize;
+        used = 0;
+        return Allocate(bytes, alignment);
+    }
+
+    void MonotonicArena::Release()
+    {
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+#if defined(__linux__)
+            if (blocks[i].mapped) munmap(blocks[i].base, blocks[i].size);
+#else
+            ::operator delete(blocks[i].base);
+#endif
+        }
+        vector<Block>().swap(blocks);
+        current = nullptr;
+        capacity = used = usedBefore = reserved = hugeTlbBlocks = 0;
+    }
+}
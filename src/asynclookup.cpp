@@ -0,0 +1,168 @@
+#include "asynclookup.h"
+
+
+namespace symspell {
+
+    template <typename Engine>
+    BasicAsyncLookup<Engine>::BasicAsyncLookup(Engine& engine, size_t threads, size_t queueCapacity, Backpressure backpressure)
+    {
+        if (threads < 1) throw std::invalid_argument("threads");
+        if (queueCapacity < 1) throw std::invalid_argument("queueCapacity");
+        this->engine = &engine;
+        this->queueCapacity = queueCapacity;
+        this->backpressure = backpressure;
+        for (size_t i = 0; i < threads; ++i) workers.push_back(std::thread([this] { Work(); }));
+    }
+
+    template <typename Engine>
+    BasicAsyncLookup<Engine>::~BasicAsyncLookup()
+    {
+        Shutdown();
+    }
+
+    template <typename Engine>
+    void BasicAsyncLookup<Engine>::Complete(Job& job, AsyncLookupResult::Status status)
+    {
+        AsyncLookupResult result;
+        result.ticket = job.ticket;
+        result.status = status;
+        job.done(result);
+    }
+
+    template <typename Engine>
+    uint64_t BasicAsyncLookup<Engine>::LookupAsync(const string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, Callback done)
+    {
+        // checked here rather than failing later on a worker
+        if (maxEditDistance < 0 || (size_t)maxEditDistance > engine->MaxDictionaryEditDistance()) throw std::invalid_argument("maxEditDistance");
+        if (!done) throw std::invalid_argument("done");
+
+        Job job;
+        job.input = input;
+        job.verbosity = verbosity;
+        job.maxEditDistance = maxEditDistance;
+        job.includeUnknown = includeUnknown;
+        job.done = std::move(done);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job.ticket = nextTicket++;
+            if (backpressure == Backpressure::Block)
+                spaceReady.wait(lock, [this] { return stopping || jobs.size() < queueCapacity; });
+            if (!stopping && jobs.size() < queueCapacity)
+            {
+                uint64_t ticket = job.ticket;
+                jobs.push_back(std::move(job));
+                jobReady.notify_one();
+                return ticket;
+            }
+        }
+        Complete(job, AsyncLookupResult::Rejected);
+        return job.ticket;
+    }
+
+    template <typename Engine>
+    std::future<AsyncLookupResult> BasicAsyncLookup<Engine>::LookupAsync(const string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, uint64_t* ticket)
+    {
+        // std::function needs a copyable callable, so the promise is shared
+        std::shared_ptr<std::promise<AsyncLookupResult>> promise = std::make_shared<std::promise<AsyncLookupResult>>();
+        std::future<AsyncLookupResult> future = promise->get_future();
+        uint64_t queued = LookupAsync(input, verbosity, maxEditDistance, includeUnknown, [promise](AsyncLookupResult& result)
+        {
+            promise->set_value(std::move(result));
+        });
+        if (ticket != nullptr) *ticket = queued;
+        return future;
+    }
+
+    template <typename Engine>
+    std::future<AsyncLookupResult> BasicAsyncLookup<Engine>::LookupAsync(const string& input, Verbosity verbosity)
+    {
+        return LookupAsync(input, verbosity, (int)engine->MaxDictionaryEditDistance(), false);
+    }
+
+    template <typename Engine>
+    bool BasicAsyncLookup<Engine>::Cancel(uint64_t ticket)
+    {
+        Job job;
+        {
+            lock_guard<std::mutex> lock(mutex);
+            typename std::deque<Job>::iterator it = jobs.begin();
+            while (it != jobs.end() && it->ticket != ticket) ++it;
+            if (it == jobs.end()) return false;
+            job = std::move(*it);
+            jobs.erase(it);
+            spaceReady.notify_one();
+        }
+        Complete(job, AsyncLookupResult::Cancelled);
+        return true;
+    }
+
+    template <typename Engine>
+    size_t BasicAsyncLookup<Engine>::CancelAll()
+    {
+        std::deque<Job> cancelled;
+        {
+            lock_guard<std::mutex> lock(mutex);
+            cancelled.swap(jobs);
+            spaceReady.notify_all();
+        }
+        for (size_t i = 0; i < cancelled.size(); ++i) Complete(cancelled[i], AsyncLookupResult::Cancelled);
+        return cancelled.size();
+    }
+
+    template <typename Engine>
+    void BasicAsyncLookup<Engine>::Shutdown()
+    {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            jobReady.notify_all();
+            spaceReady.notify_all();
+        }
+        CancelAll();
+        for (size_t i = 0; i < workers.size(); ++i)
+            if (workers[i].joinable()) workers[i].join();
+    }
+
+    template <typename Engine>
+    size_t BasicAsyncLookup<Engine>::Pending()
+    {
+        lock_guard<std::mutex> lock(mutex);
+        return jobs.size();
+    }
+
+    template <typename Engine>
+    void BasicAsyncLookup<Engine>::Work()
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                spaceReady.notify_one();
+            }
+
+            AsyncLookupResult result;
+            result.ticket = job.ticket;
+            try
+            {
+                engine->Lookup(job.input, job.verbosity, job.maxEditDistance, job.includeUnknown, result.suggestions);
+                result.status = AsyncLookupResult::Done;
+            }
+            catch (const std::exception& e)
+            {
+                result.suggestions.clear();
+                result.status = AsyncLookupResult::Failed;
+                result.error = e.what();
+            }
+            job.done(result);
+        }
+    }
+
+    template class BasicAsyncLookup<BasicSymSpell<StdMapPolicy>>;
+    template class BasicAsyncLookup<BasicSymSpell<FlatMapPolicy>>;
+}
@@ -0,0 +1,198 @@
+#include "corpuscounter.h"
+#include <thread>
+
+
+namespace symspell {
+
+    namespace {
+        // bytes of text per chunk handed to a thread
+        const size_t chunkBytes = 8 << 20;
+
+        // code point of the UTF-8 sequence at s[i], whose byte count goes to length; a malformed sequence is one byte, read as U+FFFD
+        uint32_t DecodeUtf8(const string& s, size_t i, size_t& length)
+        {
+            unsigned char c = (unsigned char)s[i];
+            length = 1;
+            if (c < 0x80) return c;
+            size_t n = c >= 0xF8 ? 0 : c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 0;
+            if (n == 0 || i + n > s.size()) return 0xFFFD;
+            uint32_t code = c & (0x7F >> n);
+            for (size_t k = 1; k < n; ++k)
+            {
+                unsigned char next = (unsigned char)s[i + k];
+                if ((next & 0xC0) != 0x80) return 0xFFFD;
+                code = (code << 6) | (next & 0x3F);
+            }
+            length = n;
+            return code;
+        }
+
+        // separators are the non-letters of ASCII and Latin-1 and the punctuation and symbol blocks below;
+        // every other code point (letters of any script, combining marks) is part of a word
+        bool IsLetter(uint32_t c)
+        {
+            if (c < 0x80) return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            // Latin-1 controls, punctuation and symbols (no-break space, guillemets, ...) except the letters ª µ º
+            if (c < 0xC0) return c == 0xAA || c == 0xB5 || c == 0xBA;
+            if (c == 0xD7 || c == 0xF7) return false;
+            // general punctuation (dashes, quotes, spaces) through currency, arrows, math and miscellaneous symbols
+            if (c >= 0x2000 && c <= 0x2BFF) return false;
+            // supplemental punctuation, CJK symbols and punctuation
+            if ((c >= 0x2E00 && c <= 0x2E7F) || (c >= 0x3000 && c <= 0x303F)) return false;
+            // fullwidth digits and punctuation, halfwidth CJK punctuation; fullwidth Latin letters stay letters
+            if (c >= 0xFF00 && c <= 0xFF65) return (c >= 0xFF21 && c <= 0xFF3A) || (c >= 0xFF41 && c <= 0xFF5A);
+            // specials (U+FFFD stands for malformed input), emoji and pictographs
+            if ((c >= 0xFFF0 && c <= 0xFFFF) || (c >= 0x1F000 && c <= 0x1FAFF)) return false;
+            return true;
+        }
+    }
+
+    CorpusCounter::CorpusCounter(long countThreshold, size_t threads, size_t sketchWidth, size_t sketchDepth)
+    {
+        if (countThreshold < 0) throw std::invalid_argument("countThreshold");
+        if (sketchWidth > 0 && sketchDepth < 1) throw std::invalid_argument("sketchDepth");
+        this->countThreshold = countThreshold;
+        this->threads = max((size_t)1, threads);
+        this->sketchDepth = sketchDepth;
+        if (sketchWidth == 0) return;
+        size_t width = 1;
+        while (width < sketchWidth) width <<= 1;
+        sketchMask = width - 1;
+        sketch.reset(new std::atomic<uint32_t>[width * sketchDepth]);
+        for (size_t i = 0; i < width * sketchDepth; ++i) sketch[i].store(0, std::memory_order_relaxed);
+    }
+
+    template <typename Visit>
+    void CorpusCounter::ForEachWord(const string& path, const Chunk& chunk, Visit visit) const
+    {
+        ifstream stream(path, ios::binary);
+        size_t position = chunk.begin;
+        string line, word;
+        // a line that starts before the chunk belongs to the previous chunk
+        if (position > 0)
+        {
+            stream.seekg(position - 1);
+            getline(stream, line);
+            position += line.size();
+        }
+        while (position < chunk.end && getline(stream, line))
+        {
+            position += line.size() + 1;
+            word.clear();
+            for (size_t i = 0, length = 0; i < line.size(); i += length)
+            {
+                if (IsLetter(DecodeUtf8(line, i, length)))
+                {
+                    if (length == 1) word += (line[i] >= 'A' && line[i] <= 'Z') ? (char)(line[i] - 'A' + 'a') : line[i];
+                    else word.append(line, i, length);
+                    continue;
+                }
+                if (!word.empty()) visit(word);
+                word.clear();
+            }
+            if (!word.empty()) visit(word);
+        }
+    }
+
+    void CorpusCounter::AddToSketch(const string& word)
+    {
+        uint64_t hash = hash64(word.data(), word.size());
+        uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+        for (size_t row = 0; row < sketchDepth; ++row)
+            sketch[row * (sketchMask + 1) + ((h1 + row * h2) & sketchMask)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t CorpusCounter::SketchEstimate(const string& word) const
+    {
+        uint64_t hash = hash64(word.data(), word.size());
+        uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+        uint32_t estimate = std::numeric_limits<uint32_t>::max();
+        for (size_t row = 0; row < sketchDepth; ++row)
+            estimate = min(estimate, sketch[row * (sketchMask + 1) + ((h1 + row * h2) & sketchMask)].load(std::memory_order_relaxed));
+        return estimate;
+    }
+
+    template <typename Work>
+    void CorpusCounter::RunChunks(const vector<Chunk>& chunks, Work work)
+    {
+        std::atomic<size_t> next(0);
+        auto run = [&](size_t thread)
+        {
+            for (size_t i = next++; i < chunks.size(); i = next++) work(chunks[i], thread);
+        };
+        vector<std::thread> workers;
+        for (size_t t = 1; t < threads; ++t) workers.push_back(std::thread(run, t));
+        run(0);
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+    }
+
+    bool CorpusCounter::Count(const vector<string>& paths)
+    {
+        vector<Chunk> chunks;
+        for (size_t f = 0; f < paths.size(); ++f)
+        {
+            ifstream stream(paths[f], ios::binary | ios::ate);
+            if (!stream.is_open()) return false;
+            size_t size = (size_t)stream.tellg();
+            for (size_t begin = 0; begin < size; begin += chunkBytes)
+                chunks.push_back(Chunk{ f, begin, min(size, begin + chunkBytes) });
+        }
+
+        vector<size_t> threadTokens(threads, 0);
+        if (sketch)
+        {
+            RunChunks(chunks, [&](const Chunk& chunk, size_t)
+            {
+                ForEachWord(paths[chunk.file], chunk, [this](const string& word) { AddToSketch(word); });
+            });
+        }
+
+        vector<unordered_map<string, long>> threadCounts(threads);
+        RunChunks(chunks, [&](const Chunk& chunk, size_t thread)
+        {
+            unordered_map<string, long>& local = threadCounts[thread];
+            size_t& localTokens = threadTokens[thread];
+            ForEachWord(paths[chunk.file], chunk, [&](const string& word)
+            {
+                ++localTokens;
+                if (sketch && (long)SketchEstimate(word) < countThreshold) return;
+                ++local[word];
+            });
+        });
+
+        tokens = 0;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            tokens += threadTokens[t];
+            for (auto it = threadCounts[t].begin(); it != threadCounts[t].end(); ++it) counts[it->first] += it->second;
+            unordered_map<string, long>().swap(threadCounts[t]);
+        }
+        return true;
+    }
+
+    vector<pair<string, long>> CorpusCounter::Counts() const
+    {
+        vector<pair<string, long>> result;
+        result.reserve(counts.size());
+        for (auto it = counts.begin(); it != counts.end(); ++it)
+        {
+            // sketch estimates can pass words whose exact count stays below the threshold
+            if (sketch && it->second < countThreshold) continue;
+            result.push_back(*it);
+        }
+        std::sort(result.begin(), result.end(), [](const pair<string, long>& l, const pair<string, long>& r)
+        {
+            return l.second != r.second ? l.second > r.second : l.first < r.first;
+        });
+        return result;
+    }
+
+    bool CorpusCounter::SaveFrequencies(const string& path) const
+    {
+        ofstream stream(path);
+        if (!stream.is_open()) return false;
+        vector<pair<string, long>> result = Counts();
+        for (size_t i = 0; i < result.size(); ++i) stream << result[i].first << '\t' << result[i].second << '\n';
+        return stream.good();
+    }
+}
@@ -0,0 +1,41 @@
+#include "countquantizer.h"
+
+
+namespace symspell {
+
+    namespace {
+        // codes per doubling of the count: 65534 codes for log2 counts 0 .. 63
+        const double scale = 65534.0 / 63.0;
+    }
+
+    uint16_t CountQuantizer::Encode(long count)
+    {
+        if (count <= 0) return 0;
+        long code = 1 + lround(log2((double)count) * scale);
+        return (uint16_t)min(code, 65535L);
+    }
+
+    double CountQuantizer::Step()
+    {
+        return exp2(1.0 / scale) - 1.0;
+    }
+
+    CountQuantizer::Table::Table() : counts(65536), log10Counts(65536)
+    {
+        counts[0] = 0;
+        log10Counts[0] = -std::numeric_limits<double>::infinity();
+        for (size_t code = 1; code < counts.size(); ++code)
+        {
+            double log2Count = (code - 1) / scale;
+            // exp2(63) does not fit a long
+            counts[code] = log2Count >= 63.0 ? std::numeric_limits<long>::max() : (long)llround(exp2(log2Count));
+            log10Counts[code] = log2Count * log10(2.0);
+        }
+    }
+
+    const CountQuantizer::Table& CountQuantizer::Tables()
+    {
+        static const Table table;
+        return table;
+    }
+}
@@ -0,0 +1,69 @@
+#include "deletefilter.h"
+#include "memoryusage.h"
+#include <bitset>
+
+
+namespace symspell {
+
+    void DeleteFilter::Build(size_t keys, double bitsPerKey)
+    {
+        if (bitsPerKey <= 0) throw std::invalid_argument("bitsPerKey");
+        size_t bits = (size_t)ceil(max((size_t)1, keys) * bitsPerKey);
+        blockCount = max((size_t)1, (bits + 255) / 256);
+        if (blockCount > 0xffffffffULL) throw std::invalid_argument("keys");
+        words.assign(blockCount * 8 + 8, 0);
+        this->keys = 0;
+        this->capacity = keys;
+        this->bitsPerKey = bitsPerKey;
+    }
+
+    void DeleteFilter::Clear()
+    {
+        vector<uint32_t>().swap(words);
+        blockCount = 0;
+        keys = 0;
+        capacity = 0;
+    }
+
+    size_t DeleteFilter::MemoryUsage() const
+    {
+        return memory::VectorHeapBytes(words);
+    }
+
+    double DeleteFilter::FillRatio() const
+    {
+        if (blockCount == 0) return 0;
+        const uint32_t* base = Base();
+        size_t set = 0;
+        for (size_t i = 0; i < blockCount * 8; ++i) set += std::bitset<32>(base[i]).count();
+        return (double)set / (blockCount * 256);
+    }
+
+    double DeleteFilter::EstimatedFalsePositiveRate() const
+    {
+        if (blockCount == 0) return 1;
+        // a foreign key passes if the bit it picks in each of the eight words of its block is set
+        const uint32_t* base = Base();
+        double sum = 0;
+        for (size_t b = 0; b < blockCount; ++b)
+        {
+            double pass = 1;
+            for (int i = 0; i < 8; ++i) pass *= std::bitset<32>(base[b * 8 + i]).count() / 32.0;
+            sum += pass;
+        }
+        return sum / blockCount;
+    }
+
+    std::string DeleteFilterReport::ToString() const
+    {
+        std::stringstream ss;
+        ss << "keys\t" << keys << "\n"
+           << "bytes\t" << bytes << "\n"
+           << "bits per key\t" << bitsPerKey << "\n"
+           << "fill ratio\t" << fillRatio << "\n"
+           << "estimated false positive rate\t" << estimatedFalsePositiveRate << "\n"
+           << "measured false positive rate\t" << measuredFalsePositiveRate << "\n"
+           << "samples\t" << samples << "\n";
+        return ss.str();
+    }
+}
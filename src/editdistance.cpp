@@ -1,6 +1,6 @@
 #include "editdistance.h"
 namespace symspell {
-    int EditDistance::Compare(string & string1, string & string2, int maxDistance)
+    int EditDistance::Compare(const string & string1, const string & string2, int maxDistance)
     {
         return this->distanceComparer(string1, string2); 
     }
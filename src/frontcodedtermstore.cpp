@@ -0,0 +1,132 @@
+#include "frontcodedtermstore.h"
+#include "memoryusage.h"
+
+
+namespace symspell {
+
+    FrontCodedTermStore::FrontCodedTermStore(size_t blockSize)
+    {
+        if (blockSize < 1) throw std::invalid_argument("blockSize");
+        this->blockSize = blockSize;
+    }
+
+    void FrontCodedTermStore::Clear()
+    {
+        vector<uint8_t>().swap(data);
+        vector<uint32_t>().swap(blockOffsets);
+        count = 0;
+    }
+
+    void FrontCodedTermStore::WriteVarint(vector<uint8_t>& out, size_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+    const uint8_t* FrontCodedTermStore::ReadVarint(const uint8_t* p, size_t& value)
+    {
+        value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            uint8_t byte = *p++;
+            value |= (size_t)(byte & 0x7f) << shift;
+            if (byte < 0x80) return p;
+        }
+    }
+
+    void FrontCodedTermStore::Build(vector<string> terms)
+    {
+        Clear();
+        std::sort(terms.begin(), terms.end());
+        terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+        if (terms.size() > 0xffffffffULL) throw std::invalid_argument("terms");
+
+        for (size_t i = 0; i < terms.size(); ++i)
+        {
+            const string& term = terms[i];
+            if (i % blockSize == 0)
+            {
+                if (data.size() > 0xffffffffULL) throw std::invalid_argument("terms");
+                blockOffsets.push_back((uint32_t)data.size());
+                WriteVarint(data, term.size());
+                data.insert(data.end(), term.begin(), term.end());
+                continue;
+            }
+            const string& previous = terms[i - 1];
+            size_t shared = 0, limit = min(previous.size(), term.size());
+            while (shared < limit && previous[shared] == term[shared]) ++shared;
+            WriteVarint(data, shared);
+            WriteVarint(data, term.size() - shared);
+            data.insert(data.end(), term.begin() + shared, term.end());
+        }
+        data.shrink_to_fit();
+        blockOffsets.shrink_to_fit();
+        count = terms.size();
+    }
+
+    const uint8_t* FrontCodedTermStore::Next(const uint8_t* p, bool head, string& term)
+    {
+        size_t shared = 0, length;
+        if (!head) p = ReadVarint(p, shared);
+        p = ReadVarint(p, length);
+        term.resize(shared);
+        term.append((const char*)p, length);
+        return p + length;
+    }
+
+    void FrontCodedTermStore::Term(uint32_t id, string& term) const
+    {
+        if (id >= count) throw std::invalid_argument("id");
+        size_t block = id / blockSize;
+        const uint8_t* p = data.data() + blockOffsets[block];
+        size_t first = block * blockSize;
+        term.clear();
+        for (size_t i = first; i <= id; ++i) p = Next(p, i == first, term);
+    }
+
+    int FrontCodedTermStore::CompareHead(size_t block, const string& term) const
+    {
+        size_t length;
+        const uint8_t* p = ReadVarint(data.data() + blockOffsets[block], length);
+        int c = memcmp(p, term.data(), min(length, term.size()));
+        if (c != 0) return c;
+        return length < term.size() ? -1 : (length > term.size() ? 1 : 0);
+    }
+
+    bool FrontCodedTermStore::Find(const string& term, uint32_t& id) const
+    {
+        if (count == 0) return false;
+        // last block whose head is <= term
+        size_t lo = 0, hi = blockOffsets.size();
+        while (hi - lo > 1)
+        {
+            size_t mid = (lo + hi) / 2;
+            if (CompareHead(mid, term) <= 0) lo = mid;
+            else hi = mid;
+        }
+        string decoded;
+        const uint8_t* p = data.data() + blockOffsets[lo];
+        size_t first = lo * blockSize, last = min(count, first + blockSize);
+        for (size_t i = first; i < last; ++i)
+        {
+            p = Next(p, i == first, decoded);
+            int c = decoded.compare(term);
+            if (c == 0)
+            {
+                id = (uint32_t)i;
+                return true;
+            }
+            if (c > 0) return false;
+        }
+        return false;
+    }
+
+    size_t FrontCodedTermStore::MemoryUsage() const
+    {
+        return memory::VectorHeapBytes(data) + memory::VectorHeapBytes(blockOffsets);
+    }
+}
@@ -0,0 +1,180 @@
+#include "frozenwordtable.h"
+#include "memoryusage.h"
+#include <thread>
+
+
+namespace symspell {
+
+    namespace {
+        // average words per bucket: larger buckets mean fewer pilots but longer pilot searches
+        const size_t wordsPerBucket = 4;
+        // pilot search limit per bucket before the build starts over with another seed
+        const uint32_t maxPilot = 1U << 28;
+        const size_t batchGroup = 16;
+    }
+
+    void FrozenWordTable::Clear()
+    {
+        vector<uint32_t>().swap(pilots);
+        vector<Slot>().swap(slots);
+        vector<uint64_t>().swap(packed);
+        buckets = 0;
+        size = 0;
+    }
+
+    void FrozenWordTable::Build(const vector<pair<string, long>>& words, bool quantizeCounts)
+    {
+        Clear();
+        if (words.empty()) return;
+        if (words.size() > 0xffffffffULL) throw std::invalid_argument("words");
+        // a seed fails only if two words share a 64 bit hash or a pilot search runs out
+        uint64_t seed = defaultHashSeed;
+        for (int attempt = 0; attempt < 64; ++attempt, seed = hash64((const char*)&seed, sizeof(seed), seed))
+            if (TryBuild(words, seed, quantizeCounts)) return;
+        throw std::logic_error("FrozenWordTable::Build");
+    }
+
+    bool FrozenWordTable::TryBuild(const vector<pair<string, long>>& words, uint64_t seed, bool quantizeCounts)
+    {
+        size_t n = words.size();
+        this->seed = seed;
+        size = n;
+        if (quantizeCounts) packed.assign(n, 0);
+        else slots.assign(n, Slot());
+        buckets = (n + wordsPerBucket - 1) / wordsPerBucket;
+        pilots.assign(buckets, 0);
+
+        vector<uint64_t> hashes(n);
+        for (size_t i = 0; i < n; ++i) hashes[i] = hash64(words[i].first.data(), words[i].first.size(), seed);
+
+        // words grouped by bucket (counting sort), buckets placed largest first
+        vector<uint32_t> bucketStart(buckets + 1, 0), order(n);
+        for (size_t i = 0; i < n; ++i) ++bucketStart[Bucket(hashes[i]) + 1];
+        for (size_t b = 0; b < buckets; ++b) bucketStart[b + 1] += bucketStart[b];
+        {
+            vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+            for (size_t i = 0; i < n; ++i) order[fill[Bucket(hashes[i])]++] = (uint32_t)i;
+        }
+        vector<uint32_t> bucketOrder(buckets);
+        for (size_t b = 0; b < buckets; ++b) bucketOrder[b] = (uint32_t)b;
+        std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&](uint32_t l, uint32_t r)
+        {
+            return bucketStart[l + 1] - bucketStart[l] > bucketStart[r + 1] - bucketStart[r];
+        });
+
+        vector<uint8_t> taken(n, 0);
+        vector<size_t> positions;
+        for (size_t o = 0; o < buckets; ++o)
+        {
+            uint32_t b = bucketOrder[o];
+            const uint32_t* members = order.data() + bucketStart[b];
+            size_t size = bucketStart[b + 1] - bucketStart[b];
+            if (size == 0) break;
+
+            for (size_t i = 0; i < size; ++i)
+                for (size_t j = i + 1; j < size; ++j)
+                    if (hashes[members[i]] == hashes[members[j]])
+                    {
+                        if (words[members[i]].first == words[members[j]].first) throw std::invalid_argument("duplicate word " + words[members[i]].first);
+                        return false;
+                    }
+
+            uint32_t pilot = 0;
+            for (;; ++pilot)
+            {
+                if (pilot == maxPilot) return false;
+                positions.clear();
+                size_t i = 0;
+                for (; i < size; ++i)
+                {
+                    size_t position = Position(hashes[members[i]], pilot);
+                    if (taken[position] || std::find(positions.begin(), positions.end(), position) != positions.end()) break;
+                    positions.push_back(position);
+                }
+                if (i == size) break;
+            }
+            pilots[b] = pilot;
+            for (size_t i = 0; i < size; ++i)
+            {
+                taken[positions[i]] = 1;
+                if (quantizeCounts)
+                {
+                    uint64_t fingerprint = hashes[members[i]] >> countCodeBits << countCodeBits;
+                    packed[positions[i]] = fingerprint | CountQuantizer::Encode(words[members[i]].second);
+                    continue;
+                }
+                slots[positions[i]].hash = hashes[members[i]];
+                slots[positions[i]].count = words[members[i]].second;
+            }
+        }
+        return true;
+    }
+
+    void FrozenWordTable::FindRange(const string* words, size_t n, uint8_t* known, long* counts) const
+    {
+        size_t positions[batchGroup];
+        uint64_t hashes[batchGroup];
+        for (size_t start = 0; start < n; start += batchGroup)
+        {
+            size_t group = min(batchGroup, n - start);
+            // hash the whole group and start loading its slots before the first one is compared
+            for (size_t i = 0; i < group; ++i)
+            {
+                const string& word = words[start + i];
+                hashes[i] = hash64(word.data(), word.size(), seed);
+                positions[i] = Position(hashes[i]);
+#if defined(__GNUC__)
+                if (!packed.empty()) __builtin_prefetch(&packed[positions[i]]);
+                else __builtin_prefetch(&slots[positions[i]]);
+#endif
+            }
+            for (size_t i = 0; i < group; ++i)
+            {
+                if (!packed.empty())
+                {
+                    uint64_t slot = packed[positions[i]];
+                    bool found = ((slot ^ hashes[i]) >> countCodeBits) == 0;
+                    known[start + i] = found ? 1 : 0;
+                    if (counts != nullptr) counts[start + i] = found ? CountQuantizer::Decode((uint16_t)slot) : 0;
+                    continue;
+                }
+                const Slot& slot = slots[positions[i]];
+                bool found = slot.hash == hashes[i];
+                known[start + i] = found ? 1 : 0;
+                if (counts != nullptr) counts[start + i] = found ? slot.count : 0;
+            }
+        }
+    }
+
+    void FrozenWordTable::FindBatch(const string* words, size_t n, uint8_t* known, long* counts, size_t threads) const
+    {
+        if (size == 0)
+        {
+            std::fill(known, known + n, 0);
+            if (counts != nullptr) std::fill(counts, counts + n, 0);
+            return;
+        }
+        // a thread is only worth starting for a few thousand words
+        threads = max((size_t)1, min(threads, n / 4096));
+        if (threads == 1)
+        {
+            FindRange(words, n, known, counts);
+            return;
+        }
+        vector<std::thread> workers;
+        size_t chunk = (n + threads - 1) / threads;
+        for (size_t t = 1; t < threads; ++t)
+        {
+            size_t begin = t * chunk, end = min(n, begin + chunk);
+            if (begin >= end) break;
+            workers.push_back(std::thread([=] { FindRange(words + begin, end - begin, known + begin, counts == nullptr ? nullptr : counts + begin); }));
+        }
+        FindRange(words, min(n, chunk), known, counts);
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+    }
+
+    size_t FrozenWordTable::MemoryUsage() const
+    {
+        return memory::VectorHeapBytes(pilots) + memory::VectorHeapBytes(slots) + memory::VectorHeapBytes(packed);
+    }
+}
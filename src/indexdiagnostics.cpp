@@ -0,0 +1,54 @@
+#include "indexdiagnostics.h"
+
+
+namespace symspell {
+
+    namespace {
+        size_t log2Index(size_t value)
+        {
+            size_t index = 0;
+            while (value >>= 1) ++index;
+            return index;
+        }
+
+        void histogramAdd(vector<size_t>& histogram, size_t index)
+        {
+            if (histogram.size() <= index) histogram.resize(index + 1, 0);
+            ++histogram[index];
+        }
+    }
+
+    void IndexDiagnostics::AddBucket(size_t size, size_t foreign, size_t strings)
+    {
+        ++buckets;
+        deleteStrings += strings;
+        if (strings > 1) ++collidingBuckets;
+        entries += size;
+        foreignEntries += foreign;
+        maxBucketSize = max(maxBucketSize, size);
+        maxForeignEntries = max(maxForeignEntries, foreign);
+        histogramAdd(bucketSizeHistogram, size == 0 ? 0 : log2Index(size));
+        histogramAdd(foreignEntriesHistogram, foreign == 0 ? 0 : log2Index(foreign) + 1);
+    }
+
+    std::string IndexDiagnostics::ToString() const
+    {
+        std::stringstream ss;
+        ss << "buckets\t" << buckets << "\n"
+           << "delete strings\t" << deleteStrings << "\n"
+           << "colliding buckets\t" << collidingBuckets << "\t(" << CollisionRate() * 100 << "%)\n"
+           << "entries\t" << entries << "\n"
+           << "foreign entries\t" << foreignEntries << "\t(" << ForeignRate() * 100 << "%)\n"
+           << "max bucket size\t" << maxBucketSize << "\n"
+           << "max foreign entries\t" << maxForeignEntries << "\n";
+        for (size_t i = 0; i < bucketSizeHistogram.size(); ++i)
+            ss << "bucket size " << ((size_t)1 << i) << "-" << ((size_t)2 << i) - 1 << "\t" << bucketSizeHistogram[i] << "\n";
+        for (size_t i = 0; i < foreignEntriesHistogram.size(); ++i)
+        {
+            if (i == 0) ss << "foreign 0";
+            else ss << "foreign " << ((size_t)1 << (i - 1)) << "-" << ((size_t)1 << i) - 1;
+            ss << "\t" << foreignEntriesHistogram[i] << "\n";
+        }
+        return ss.str();
+    }
+}
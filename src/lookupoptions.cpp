@@ -0,0 +1,27 @@
+#include "lookupoptions.h"
+
+
+namespace symspell {
+
+    EditDistanceByLength::EditDistanceByLength(vector<int> table)
+    {
+        for (size_t i = 0; i < table.size(); ++i)
+            if (table[i] < 0) throw std::invalid_argument("table");
+        this->table = std::move(table);
+    }
+
+    size_t EditDistanceByLength::CodePoints(const string& s)
+    {
+        size_t n = 0;
+        for (size_t i = 0; i < s.size(); ++i)
+            if (((uint8_t)s[i] & 0xc0) != 0x80) ++n;
+        return n;
+    }
+
+    int EditDistanceByLength::For(const string& input, int maxEditDistance) const
+    {
+        if (table.empty()) return maxEditDistance;
+        size_t length = min(CodePoints(input), table.size() - 1);
+        return min(maxEditDistance, table[length]);
+    }
+}
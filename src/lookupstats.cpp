@@ -0,0 +1,128 @@
+#include "lookupstats.h"
+#include <atomic>
+
+
+namespace symspell {
+
+    namespace {
+        uint64_t LookupStats::* const statsFields[] = {
+            &LookupStats::lookups,
+            &LookupStats::candidatesGenerated,
+            &LookupStats::bucketsProbed,
+            &LookupStats::bucketsHit,
+            &LookupStats::filterRejected,
+            &LookupStats::entriesScanned,
+            &LookupStats::entriesSkipped,
+            &LookupStats::rejectedExact,
+            &LookupStats::rejectedLength,
+            &LookupStats::rejectedCollision,
+            &LookupStats::rejectedPrefixLength,
+            &LookupStats::rejectedSuffix,
+            &LookupStats::rejectedDeleteInPrefix,
+            &LookupStats::rejectedDuplicate,
+            &LookupStats::rejectedDistance,
+            &LookupStats::distanceComputations,
+            &LookupStats::earlyExits,
+            &LookupStats::truncated,
+            &LookupStats::segmentations,
+            &LookupStats::segmentationParts
+        };
+        const char* const statsNames[] = {
+            "lookups", "candidatesGenerated", "bucketsProbed", "bucketsHit", "filterRejected", "entriesScanned", "entriesSkipped",
+            "rejectedExact", "rejectedLength", "rejectedCollision", "rejectedPrefixLength", "rejectedSuffix",
+            "rejectedDeleteInPrefix", "rejectedDuplicate", "rejectedDistance", "distanceComputations", "earlyExits", "truncated",
+            "segmentations", "segmentationParts"
+        };
+        const size_t statsFieldCount = sizeof(statsFields) / sizeof(statsFields[0]);
+
+        struct ThreadSlot;
+
+        struct Registry
+        {
+            std::mutex mtx;
+            vector<ThreadSlot*> slots;
+            LookupStats retired;
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry* registry = new Registry(); // never destroyed, threads may exit after main
+            return *registry;
+        }
+
+        struct ThreadSlot
+        {
+            std::atomic<uint64_t> counters[statsFieldCount];
+
+            ThreadSlot()
+            {
+                for (size_t i = 0; i < statsFieldCount; ++i) counters[i].store(0, std::memory_order_relaxed);
+                Registry& registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mtx);
+                registry.slots.push_back(this);
+            }
+
+            ~ThreadSlot()
+            {
+                Registry& registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mtx);
+                for (size_t i = 0; i < statsFieldCount; ++i)
+                    registry.retired.*statsFields[i] += counters[i].load(std::memory_order_relaxed);
+                registry.slots.erase(std::find(registry.slots.begin(), registry.slots.end(), this));
+            }
+        };
+    }
+
+    LookupStats& LookupStats::operator+=(const LookupStats& other)
+    {
+        for (size_t i = 0; i < statsFieldCount; ++i) this->*statsFields[i] += other.*statsFields[i];
+        return *this;
+    }
+
+    LookupStats LookupStats::operator-(const LookupStats& other) const
+    {
+        LookupStats difference(*this);
+        for (size_t i = 0; i < statsFieldCount; ++i) difference.*statsFields[i] -= other.*statsFields[i];
+        return difference;
+    }
+
+    std::string LookupStats::ToString() const
+    {
+        std::stringstream ss;
+        for (size_t i = 0; i < statsFieldCount; ++i) ss << statsNames[i] << "\t" << this->*statsFields[i] << "\n";
+        return ss.str();
+    }
+
+    bool LookupStatsRegistry::Enabled()
+    {
+#ifdef SYMSPELL_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void LookupStatsRegistry::Accumulate(const LookupStats& stats)
+    {
+        // only the owning thread writes its slot, so a relaxed load + store is enough
+        static thread_local ThreadSlot slot;
+        for (size_t i = 0; i < statsFieldCount; ++i)
+        {
+            uint64_t value = stats.*statsFields[i];
+            if (value != 0) slot.counters[i].store(slot.counters[i].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+
+    LookupStats LookupStatsRegistry::Snapshot()
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mtx);
+        LookupStats total = registry.retired;
+        for (size_t s = 0; s < registry.slots.size(); ++s)
+        {
+            for (size_t i = 0; i < statsFieldCount; ++i)
+                total.*statsFields[i] += registry.slots[s]->counters[i].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+}
@@ -0,0 +1,26 @@
+#include "memoryusage.h"
+
+
+namespace symspell {
+
+    std::string MemoryUsage::ToString() const
+    {
+        std::stringstream ss;
+        ss << "words\t" << wordsBytes << "\n"
+           << "belowThresholdWords\t" << belowThresholdWordsBytes << "\n"
+           << "deletes table\t" << deletesTableBytes << "\n"
+           << "bucket vectors\t" << bucketVectorsBytes << "\n"
+           << "suggestion strings\t" << suggestionStringsBytes << "\n"
+           << "staging\t" << stagingBytes << "\n"
+           << "prefix index\t" << prefixIndexBytes << "\n"
+           << "delete filter\t" << deleteFilterBytes << "\n"
+           << "frozen words\t" << frozenWordsBytes << "\n"
+           << "term store\t" << termStoreBytes << "\n"
+           << "total\t" << TotalBytes() << "\n"
+           << "buckets\t" << buckets << "\n"
+           << "entries\t" << entries << "\n"
+           << "average bucket length\t" << AverageBucketLength() << "\n"
+           << "max bucket length\t" << maxBucketLength << "\n";
+        return ss.str();
+    }
+}
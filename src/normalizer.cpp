@@ -0,0 +1,109 @@
+#include "normalizer.h"
+
+
+namespace symspell {
+
+    namespace {
+        // base letters of U+00C0 .. U+017F; nullptr where the code point has no decomposition
+        const char* const latinBase[0x180 - 0xC0] = {
+            // U+00C0
+            "A", "A", "A", "A", "A", "A", "AE", "C", "E", "E", "E", "E", "I", "I", "I", "I",
+            "D", "N", "O", "O", "O", "O", "O", nullptr, "O", "U", "U", "U", "U", "Y", nullptr, "ss",
+            "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+            "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", nullptr, "y",
+            // U+0100
+            "A", "a", "A", "a", "A", "a", "C", "c", "C", "c", "C", "c", "C", "c", "D", "d",
+            "D", "d", "E", "e", "E", "e", "E", "e", "E", "e", "E", "e", "G", "g", "G", "g",
+            "G", "g", "G", "g", "H", "h", "H", "h", "I", "i", "I", "i", "I", "i", "I", "i",
+            "I", "i", "IJ", "ij", "J", "j", "K", "k", "k", "L", "l", "L", "l", "L", "l", "L",
+            // U+0140
+            "l", "L", "l", "N", "n", "N", "n", "N", "n", "n", nullptr, nullptr, "O", "o", "O", "o",
+            "O", "o", "OE", "oe", "R", "r", "R", "r", "R", "r", "S", "s", "S", "s", "S", "s",
+            "S", "s", "T", "t", "T", "t", "T", "t", "U", "u", "U", "u", "U", "u", "U", "u",
+            "U", "u", "U", "u", "W", "w", "Y", "y", "Y", "Z", "z", "Z", "z", "Z", "z", "s"
+        };
+
+        size_t lowerCodePoint(size_t cp)
+        {
+            if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp + 0x20;
+            if (cp == 0x130) return 'i';
+            if (cp == 0x178) return 0xFF;
+            if (cp >= 0x100 && cp <= 0x137 && cp != 0x131) return cp | 1;
+            if (cp >= 0x139 && cp <= 0x148) return (cp & 1) ? cp + 1 : cp;
+            if (cp >= 0x14A && cp <= 0x177) return cp | 1;
+            if (cp >= 0x179 && cp <= 0x17E) return (cp & 1) ? cp + 1 : cp;
+            return cp;
+        }
+
+        string encodeUTF8(size_t cp)
+        {
+            string result;
+            if (cp < 0x80) result += (char)cp;
+            else
+            {
+                result += (char)(0xC0 | (cp >> 6));
+                result += (char)(0x80 | (cp & 0x3F));
+            }
+            return result;
+        }
+    }
+
+    Normalizer::Normalizer(int folding)
+    {
+        if (folding < None || folding > CaseAndDiacritics) throw std::invalid_argument("folding");
+        this->folding = folding;
+
+        for (int c = 0; c < 128; ++c)
+            ascii[c] = (char)((folding & Case) && c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+
+        latin.resize(0x180 - 0x80);
+        for (size_t cp = 0x80; cp < 0x180; ++cp)
+        {
+            const char* base = cp >= 0xC0 ? latinBase[cp - 0xC0] : nullptr;
+            string& folded = latin[cp - 0x80];
+            if ((folding & Diacritics) && base != nullptr)
+            {
+                folded = base;
+                for (size_t i = 0; i < folded.size(); ++i) folded[i] = ascii[(unsigned char)folded[i]];
+            }
+            else
+                folded = encodeUTF8((folding & Case) ? lowerCodePoint(cp) : cp);
+        }
+    }
+
+    void Normalizer::Fold(const string& input, string& output) const
+    {
+        output.reserve(output.size() + input.size());
+        size_t i = 0, n = input.size();
+        while (i < n)
+        {
+            unsigned char b = (unsigned char)input[i];
+            if (b < 0x80)
+            {
+                output += ascii[b];
+                ++i;
+            }
+            else if (b >= 0xC2 && b <= 0xC5 && i + 1 < n && ((unsigned char)input[i + 1] & 0xC0) == 0x80)
+            {
+                // two byte sequence of U+0080 .. U+017F
+                size_t cp = ((size_t)(b & 0x1F) << 6) | ((unsigned char)input[i + 1] & 0x3F);
+                output += latin[cp - 0x80];
+                i += 2;
+            }
+            else
+            {
+                // outside the tables: copy the lead byte and its continuation bytes unchanged
+                output += input[i++];
+                while (i < n && ((unsigned char)input[i] & 0xC0) == 0x80) output += input[i++];
+            }
+        }
+    }
+
+    string Normalizer::Fold(const string& input) const
+    {
+        if (folding == None) return input;
+        string output;
+        Fold(input, output);
+        return output;
+    }
+}
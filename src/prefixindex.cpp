@@ -0,0 +1,179 @@
+#include "prefixindex.h"
+#include "memoryusage.h"
+
+
+namespace symspell {
+
+    void PrefixIndex::Clear()
+    {
+        text.clear();
+        offsets.clear();
+        counts.clear();
+        sparse.clear();
+    }
+
+    void PrefixIndex::Add(const string& term, long count)
+    {
+        if (offsets.empty()) offsets.push_back(0);
+        text += term;
+        offsets.push_back((uint32_t)text.size());
+        counts.push_back(count);
+    }
+
+    void PrefixIndex::Build()
+    {
+        size_t n = counts.size();
+        vector<uint32_t> order(n);
+        for (size_t i = 0; i < n; ++i) order[i] = (uint32_t)i;
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+        {
+            return text.compare(offsets[a], offsets[a + 1] - offsets[a], text, offsets[b], offsets[b + 1] - offsets[b]) < 0;
+        });
+
+        string sortedText;
+        vector<uint32_t> sortedOffsets(1, 0);
+        vector<long> sortedCounts;
+        sortedText.reserve(text.size());
+        sortedCounts.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            sortedText.append(text, offsets[order[i]], offsets[order[i] + 1] - offsets[order[i]]);
+            sortedOffsets.push_back((uint32_t)sortedText.size());
+            sortedCounts.push_back(counts[order[i]]);
+        }
+        text.swap(sortedText);
+        offsets.swap(sortedOffsets);
+        counts.swap(sortedCounts);
+
+        sparse.clear();
+        size_t blocks = (n + BlockSize - 1) >> BlockShift;
+        if (blocks == 0) return;
+        sparse.push_back(vector<uint32_t>(blocks));
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            size_t best = b << BlockShift;
+            for (size_t i = best + 1; i < min(n, (b + 1) << BlockShift); ++i) best = Better(best, i);
+            sparse[0][b] = (uint32_t)best;
+        }
+        for (size_t j = 1; ((size_t)1 << j) <= blocks; ++j)
+        {
+            size_t half = (size_t)1 << (j - 1);
+            sparse.push_back(vector<uint32_t>(blocks - (half << 1) + 1));
+            for (size_t b = 0; b < sparse[j].size(); ++b)
+                sparse[j][b] = (uint32_t)Better(sparse[j - 1][b], sparse[j - 1][b + half]);
+        }
+    }
+
+    size_t PrefixIndex::ArgMax(size_t lo, size_t hi) const
+    {
+        size_t firstBlock = (lo + BlockSize - 1) >> BlockShift;
+        size_t lastBlock = hi >> BlockShift; // exclusive
+        if (firstBlock >= lastBlock)
+        {
+            size_t best = lo;
+            for (size_t i = lo + 1; i < hi; ++i) best = Better(best, i);
+            return best;
+        }
+
+        size_t best = sparse[0][firstBlock];
+        for (size_t i = lo; i < (firstBlock << BlockShift); ++i) best = Better(best, i);
+        for (size_t i = lastBlock << BlockShift; i < hi; ++i) best = Better(best, i);
+        size_t span = lastBlock - firstBlock, j = 0;
+        while (((size_t)2 << j) <= span) ++j;
+        best = Better(best, sparse[j][firstBlock]);
+        best = Better(best, sparse[j][lastBlock - ((size_t)1 << j)]);
+        return best;
+    }
+
+    int PrefixIndex::ComparePrefix(size_t id, const string& prefix) const
+    {
+        size_t len = TermLength(id);
+        size_t n = min(len, prefix.size());
+        int c = text.compare(offsets[id], n, prefix, 0, n);
+        if (c != 0) return c;
+        return len < prefix.size() ? -1 : 0;
+    }
+
+    pair<size_t, size_t> PrefixIndex::Range(const string& prefix) const
+    {
+        size_t lo = 0, hi = Size();
+        while (lo < hi)
+        {
+            size_t mid = (lo + hi) >> 1;
+            if (ComparePrefix(mid, prefix) < 0) lo = mid + 1; else hi = mid;
+        }
+        size_t first = lo;
+        hi = Size();
+        while (lo < hi)
+        {
+            size_t mid = (lo + hi) >> 1;
+            if (ComparePrefix(mid, prefix) <= 0) lo = mid + 1; else hi = mid;
+        }
+        return make_pair(first, lo);
+    }
+
+    pair<size_t, size_t> PrefixIndex::Narrow(size_t lo, size_t hi, size_t depth, unsigned char c) const
+    {
+        // within [lo, hi) the byte at depth is non decreasing (terms ending at depth sort first as -1)
+        size_t a = lo, b = hi;
+        while (a < b)
+        {
+            size_t mid = (a + b) >> 1;
+            if (CharAt(mid, depth) < (int)c) a = mid + 1; else b = mid;
+        }
+        size_t first = a;
+        b = hi;
+        while (a < b)
+        {
+            size_t mid = (a + b) >> 1;
+            if (CharAt(mid, depth) <= (int)c) a = mid + 1; else b = mid;
+        }
+        return make_pair(first, a);
+    }
+
+    void PrefixIndex::TopK(size_t lo, size_t hi, size_t k, vector<size_t>& ids) const
+    {
+        ids.clear();
+        if (lo >= hi || k == 0) return;
+
+        // heap of (argmax, lo, hi) ordered by the count at argmax
+        typedef std::tuple<size_t, size_t, size_t> Span;
+        auto less = [this](const Span& a, const Span& b)
+        {
+            long ca = counts[std::get<0>(a)], cb = counts[std::get<0>(b)];
+            return ca != cb ? ca < cb : std::get<0>(a) > std::get<0>(b);
+        };
+        std::priority_queue<Span, vector<Span>, decltype(less)> heap(less);
+        heap.push(Span(ArgMax(lo, hi), lo, hi));
+        while (!heap.empty() && ids.size() < k)
+        {
+            Span top = heap.top();
+            heap.pop();
+            size_t best = std::get<0>(top), spanLo = std::get<1>(top), spanHi = std::get<2>(top);
+            ids.push_back(best);
+            if (spanLo < best) heap.push(Span(ArgMax(spanLo, best), spanLo, best));
+            if (best + 1 < spanHi) heap.push(Span(ArgMax(best + 1, spanHi), best + 1, spanHi));
+        }
+    }
+
+    void PrefixIndex::Complete(const string& prefix, size_t k, vector<std::unique_ptr<symspell::SuggestItem>>& items) const
+    {
+        items.clear();
+        pair<size_t, size_t> range = Range(prefix);
+        vector<size_t> ids;
+        TopK(range.first, range.second, k, ids);
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            std::unique_ptr<SuggestItem> item(new SuggestItem(Term(ids[i]), 0, counts[ids[i]]));
+            items.push_back(std::move(item));
+        }
+    }
+
+    size_t PrefixIndex::MemoryUsage() const
+    {
+        size_t bytes = memory::StringHeapBytes(text) + memory::VectorHeapBytes(offsets) + memory::VectorHeapBytes(counts)
+            + memory::VectorHeapBytes(sparse);
+        for (size_t j = 0; j < sparse.size(); ++j) bytes += memory::VectorHeapBytes(sparse[j]);
+        return bytes;
+    }
+}
@@ -0,0 +1,188 @@
+#include "prefixsession.h"
+
+
+namespace symspell {
+
+    PrefixSession::PrefixSession(const PrefixIndex& index, int maxEditDistance)
+    {
+        if (maxEditDistance < 0) throw std::invalid_argument("maxEditDistance");
+        this->index = &index;
+        this->maxEditDistance = maxEditDistance;
+        Reset();
+    }
+
+    void PrefixSession::Compact(ActiveSet& set)
+    {
+        // the same node may have been reached along several edit paths, keep its smallest distance
+        std::sort(set.begin(), set.end(), [](const ActiveNode& a, const ActiveNode& b)
+        {
+            if (a.depth != b.depth) return a.depth < b.depth;
+            if (a.lo != b.lo) return a.lo < b.lo;
+            return a.distance < b.distance;
+        });
+        set.erase(std::unique(set.begin(), set.end(), [](const ActiveNode& a, const ActiveNode& b)
+        {
+            return a.depth == b.depth && a.lo == b.lo;
+        }), set.end());
+    }
+
+    void PrefixSession::Reset()
+    {
+        input.clear();
+        levels.clear();
+
+        // empty input: every prefix of length <= maxEditDistance is reachable by insertions only
+        ActiveSet initial;
+        if (index->Size() > 0)
+        {
+            ActiveNode root = { 0, (uint32_t)index->Size(), 0, 0 };
+            initial.push_back(root);
+            for (size_t i = 0; i < initial.size(); ++i)
+            {
+                ActiveNode node = initial[i];
+                if ((int)node.distance < maxEditDistance) AddChildren(node, node.distance + 1, initial);
+            }
+        }
+        levels.push_back(initial);
+    }
+
+    PrefixSession::ActiveNode PrefixSession::Child(const ActiveNode& node, uint32_t at, int childChar, uint32_t distance) const
+    {
+        pair<size_t, size_t> range = index->Narrow(at, node.hi, node.depth, (unsigned char)childChar);
+        ActiveNode child = { at, (uint32_t)range.second, node.depth + 1, distance };
+        return child;
+    }
+
+    void PrefixSession::AddChildren(const ActiveNode& node, uint32_t distance, ActiveSet& next) const
+    {
+        uint32_t i = node.lo;
+        while (i < node.hi)
+        {
+            int childChar = index->CharAt(i, node.depth);
+            if (childChar < 0) { ++i; continue; }
+            ActiveNode child = Child(node, i, childChar, distance);
+            i = child.hi;
+            next.push_back(child);
+        }
+    }
+
+    void PrefixSession::MatchBelow(const ActiveNode& node, uint32_t distance, int budget, unsigned char c, ActiveSet& next) const
+    {
+        // the child ending in c is found by binary search; only when more insertions are
+        // affordable do the other children have to be enumerated
+        pair<size_t, size_t> range = index->Narrow(node.lo, node.hi, node.depth, c);
+        if (range.first < range.second)
+        {
+            ActiveNode matched = { (uint32_t)range.first, (uint32_t)range.second, node.depth + 1, distance };
+            next.push_back(matched);
+        }
+        if (budget <= 1) return;
+
+        uint32_t i = node.lo;
+        while (i < node.hi)
+        {
+            int childChar = index->CharAt(i, node.depth);
+            if (childChar < 0) { ++i; continue; }
+            ActiveNode child = Child(node, i, childChar, distance + 1);
+            i = child.hi;
+            MatchBelow(child, distance + 1, budget - 1, c, next);
+        }
+    }
+
+    void PrefixSession::Push(char ch)
+    {
+        unsigned char c = (unsigned char)ch;
+        const ActiveSet& previous = levels.back();
+        ActiveSet next;
+        for (size_t n = 0; n < previous.size(); ++n)
+        {
+            const ActiveNode& node = previous[n];
+            int slack = maxEditDistance - (int)node.distance;
+
+            // c deleted from the input: same node, one more edit
+            if (slack > 0)
+            {
+                ActiveNode deleted = node;
+                deleted.distance = node.distance + 1;
+                next.push_back(deleted);
+            }
+
+            // c matched by a descendant at depth + t, after inserting the t - 1 characters in between
+            // (t = 1 .. slack + 1); the match itself keeps node.distance + t - 1
+            if (slack == 0)
+            {
+                MatchBelow(node, node.distance, 1, c, next);
+                continue;
+            }
+            uint32_t i = node.lo;
+            while (i < node.hi)
+            {
+                int childChar = index->CharAt(i, node.depth);
+                if (childChar < 0) { ++i; continue; }
+                ActiveNode child = Child(node, i, childChar, node.distance);
+                i = child.hi;
+
+                if (childChar == c) next.push_back(child);
+                else
+                {
+                    // c substituted for the child's character
+                    child.distance = node.distance + 1;
+                    next.push_back(child);
+                }
+                // or the child's character inserted before a deeper match
+                MatchBelow(child, node.distance + 1, slack, c, next);
+            }
+        }
+        Compact(next);
+        input += ch;
+        levels.push_back(std::move(next));
+    }
+
+    void PrefixSession::Pop()
+    {
+        if (input.empty()) return;
+        input.erase(input.size() - 1);
+        levels.pop_back();
+    }
+
+    void PrefixSession::Update(const string& newInput)
+    {
+        size_t common = 0;
+        while (common < input.size() && common < newInput.size() && input[common] == newInput[common]) ++common;
+        while (input.size() > common) Pop();
+        for (size_t i = common; i < newInput.size(); ++i) Push(newInput[i]);
+    }
+
+    void PrefixSession::Suggestions(size_t k, vector<std::unique_ptr<symspell::SuggestItem>>& items) const
+    {
+        items.clear();
+        const ActiveSet& active = levels.back();
+
+        // best (distance, count) per word: closer distance levels first, a level's top k per node is
+        // enough because any other word of that node's range ranks below them
+        vector<pair<size_t, uint32_t>> found; // (term id, distance)
+        unordered_set<size_t> seen;
+        vector<size_t> ids;
+        for (int distance = 0; distance <= maxEditDistance && found.size() < k; ++distance)
+        {
+            size_t levelStart = found.size();
+            for (size_t n = 0; n < active.size(); ++n)
+            {
+                if ((int)active[n].distance != distance) continue;
+                index->TopK(active[n].lo, active[n].hi, k, ids);
+                for (size_t i = 0; i < ids.size(); ++i)
+                    if (seen.insert(ids[i]).second) found.push_back(make_pair(ids[i], (uint32_t)distance));
+            }
+            std::sort(found.begin() + levelStart, found.end(), [this](const pair<size_t, uint32_t>& a, const pair<size_t, uint32_t>& b)
+            {
+                long ca = index->Count(a.first), cb = index->Count(b.first);
+                return ca != cb ? ca > cb : a.first < b.first;
+            });
+        }
+        for (size_t i = 0; i < found.size() && i < k; ++i)
+        {
+            std::unique_ptr<SuggestItem> item(new SuggestItem(index->Term(found[i].first), found[i].second, index->Count(found[i].first)));
+            items.push_back(std::move(item));
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#include "shardedsymspell.h"
+
+
+namespace symspell {
+
+    namespace {
+        // independent of the delete hash seed, so shard membership says nothing about bucket placement
+        const uint64_t shardHashSeed = 0x13198a2e03707344ULL;
+
+        // same line format as SymSpell::LoadDictionary: tab separated, lines with spaces are skipped
+        template <typename Add>
+        bool readDictionary(const string& corpus, int termIndex, int countIndex, Add add)
+        {
+            ifstream stream(corpus);
+            if (!stream.is_open()) return false;
+
+            char a = stream.get(), b = stream.get(), c = stream.get();
+            if (a != (char)0xEF || b != (char)0xBB || c != (char)0xBF) stream.seekg(0);
+
+            string line;
+            vector<string> lineParts;
+            while (getline(stream, line))
+            {
+                if (line.find(' ') != string::npos) continue;
+                lineParts.clear();
+                std::stringstream ss(line);
+                string token;
+                while (std::getline(ss, token, '\t')) lineParts.push_back(token);
+                if (lineParts.size() >= 2 && (size_t)max(termIndex, countIndex) < lineParts.size())
+                    add(lineParts[termIndex], (long)stoll(lineParts[countIndex]));
+            }
+            return true;
+        }
+    }
+
+    void LocalShard::Start(const string& input, Verbosity verbosity, int maxEditDistance)
+    {
+        this->input = input;
+        this->verbosity = verbosity;
+        this->maxEditDistance = maxEditDistance;
+    }
+
+    void LocalShard::Finish(vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    {
+        engine.Lookup(input, verbosity, maxEditDistance, false, items);
+    }
+
+    ShardedSymSpell::ShardedSymSpell(size_t shardCount, int maxDictionaryEditDistance, int prefixLength, int countThreshold)
+    {
+        if (shardCount < 1) throw std::invalid_argument("shardCount");
+        for (size_t i = 0; i < shardCount; ++i)
+            shards.push_back(std::unique_ptr<Shard>(new LocalShard(maxDictionaryEditDistance, prefixLength, countThreshold)));
+        this->maxDictionaryEditDistance = maxDictionaryEditDistance;
+        partials.resize(shardCount);
+    }
+
+    ShardedSymSpell::ShardedSymSpell(vector<std::unique_ptr<Shard>> shards, int maxDictionaryEditDistance)
+    {
+        if (shards.empty()) throw std::invalid_argument("shards");
+        if (maxDictionaryEditDistance < 0) throw std::invalid_argument("maxDictionaryEditDistance");
+        this->shards = std::move(shards);
+        this->maxDictionaryEditDistance = maxDictionaryEditDistance;
+        partials.resize(this->shards.size());
+    }
+
+    size_t ShardedSymSpell::ShardOf(const string& word, size_t shardCount)
+    {
+        return (size_t)(hash64(word.data(), word.size(), shardHashSeed) % shardCount);
+    }
+
+    bool ShardedSymSpell::LoadDictionaryShard(SymSpell& target, const string& corpus, int termIndex, int countIndex, size_t shard, size_t shardCount)
+    {
+        if (shard >= shardCount) throw std::invalid_argument("shard");
+        bool loaded = readDictionary(corpus, termIndex, countIndex, [&](const string& term, long count)
+        {
+            if (ShardOf(term, shardCount) == shard) target.CreateDictionaryEntry(term, count);
+        });
+        if (loaded) target.FinishLoading();
+        return loaded;
+    }
+
+    LocalShard& ShardedSymSpell::Local(size_t shard)
+    {
+        LocalShard* local = dynamic_cast<LocalShard*>(shards[shard].get());
+        if (local == nullptr) throw std::logic_error("words can only be added to local shards");
+        return *local;
+    }
+
+    bool ShardedSymSpell::CreateDictionaryEntry(const string& key, long count)
+    {
+        return Local(ShardOf(key, shards.size())).Engine().CreateDictionaryEntry(key, count);
+    }
+
+    bool ShardedSymSpell::LoadDictionary(const string& corpus, int termIndex, int countIndex)
+    {
+        bool loaded = readDictionary(corpus, termIndex, countIndex, [this](const string& term, long count)
+        {
+            CreateDictionaryEntry(term, count);
+        });
+        if (loaded)
+            for (size_t i = 0; i < shards.size(); ++i) Local(i).Engine().FinishLoading();
+        return loaded;
+    }
+
+    void ShardedSymSpell::Lookup(string& input, Verbosity verbosity, vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    {
+        Lookup(input, verbosity, maxDictionaryEditDistance, false, items);
+    }
+
+    void ShardedSymSpell::Lookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions)
+    {
+        if (maxEditDistance > maxDictionaryEditDistance) throw std::invalid_argument("maxEditDistance");
+        suggestions.clear();
+
+        // scatter, then gather. The shard owning the input is collected first: only it can hold an
+        // exact match, and then Top and Closest need nothing from the others.
+        size_t owner = ShardOf(input, shards.size());
+        for (size_t i = 0; i < shards.size(); ++i) shards[i]->Start(input, verbosity, maxEditDistance);
+        shards[owner]->Finish(partials[owner]);
+        bool exact = verbosity != Verbosity::All && !partials[owner].empty() && partials[owner][0]->distance == 0;
+        for (size_t i = 0; i < shards.size(); ++i)
+        {
+            if (i == owner) continue;
+            if (exact) shards[i]->Skip();
+            else shards[i]->Finish(partials[i]);
+        }
+        for (size_t i = 0; i < shards.size(); ++i)
+        {
+            for (size_t j = 0; j < partials[i].size(); ++j) suggestions.push_back(std::move(partials[i][j]));
+            partials[i].clear();
+        }
+
+        // every shard already holds its words to the verbosity rules, so the merged list only has to be
+        // ordered and cut back: Top keeps the best suggestion, Closest the ones at the smallest distance
+        std::stable_sort(suggestions.begin(), suggestions.end(), [](const std::unique_ptr<symspell::SuggestItem>& l, const std::unique_ptr<symspell::SuggestItem>& r)
+        {
+            return r->CompareTo(*l);
+        });
+        if (!suggestions.empty())
+        {
+            if (verbosity == Verbosity::Top) suggestions.resize(1);
+            else if (verbosity == Verbosity::Closest)
+            {
+                size_t closest = 1;
+                while (closest < suggestions.size() && suggestions[closest]->distance == suggestions[0]->distance) ++closest;
+                suggestions.resize(closest);
+            }
+        }
+
+        if (includeUnknown && suggestions.empty())
+        {
+            std::unique_ptr<SuggestItem> unq(new SuggestItem(input, maxEditDistance + 1, 0));
+            suggestions.push_back(std::move(unq));
+        }
+    }
+}
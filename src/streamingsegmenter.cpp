@@ -0,0 +1,203 @@
+#include "streamingsegmenter.h"
+
+
+namespace symspell {
+
+    template <typename Engine>
+    BasicStreamingSegmenter<Engine>::BasicStreamingSegmenter(Engine& engine, size_t maxEditDistance, size_t maxSegmentationWordLength, size_t maxPendingLength)
+    {
+        if (maxEditDistance > engine.MaxDictionaryEditDistance()) throw std::invalid_argument("maxEditDistance");
+        if (maxSegmentationWordLength < 1) throw std::invalid_argument("maxSegmentationWordLength");
+        if (maxPendingLength < maxSegmentationWordLength) throw std::invalid_argument("maxPendingLength");
+        this->engine = &engine;
+        this->maxEditDistance = maxEditDistance;
+        this->maxPendingLength = maxPendingLength;
+        window.resize(maxSegmentationWordLength);
+        Reset();
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Reset()
+    {
+        StartText();
+        segmentedOut.clear();
+        correctedOut.clear();
+        counters = LookupStats();
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::StartText()
+    {
+        text.clear();
+        offset = 0;
+        position = 0;
+        std::fill(window.begin(), window.end(), shared_ptr<Node>());
+        committed = std::make_shared<Node>();
+        Slot(0) = committed;
+        emitted = false;
+        finished = false;
+        textParts = counters.segmentationParts;
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Feed(const string& chunk)
+    {
+        if (finished) StartText();
+        text += chunk;
+        size_t maxLength = window.size();
+        while (offset + text.size() - position >= maxLength)
+        {
+            Step();
+            Commit();
+        }
+        // drop the input before position once it is a good part of the buffer
+        if (position - offset > 4096 && 2 * (position - offset) > text.size())
+        {
+            text.erase(0, position - offset);
+            offset = position;
+        }
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Finish()
+    {
+        if (finished) StartText();
+        size_t end = offset + text.size();
+        while (position < end)
+        {
+            Step();
+            Commit();
+        }
+        if (end > committed->end) Emit(Slot(end));
+#ifdef SYMSPELL_STATS
+        LookupStats segmentation;
+        segmentation.segmentations = 1;
+        segmentation.segmentationParts = counters.segmentationParts - textParts;
+        LookupStatsRegistry::Accumulate(segmentation);
+        counters.segmentations += 1;
+#endif
+        finished = true;
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Take(string& segmented, string& corrected)
+    {
+        segmented.swap(segmentedOut);
+        corrected.swap(correctedOut);
+        segmentedOut.clear();
+        correctedOut.clear();
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Step()
+    {
+        size_t maxLength = window.size();
+        size_t imax = min(offset + text.size() - position, maxLength);
+        // the slot of position is also the one of position + maxLength: keep the source
+        shared_ptr<Node> source = Slot(position);
+        for (size_t i = 1; i <= imax; ++i)
+        {
+            string part = text.substr(position - offset, i);
+            int separatorLength = 0;
+            double topProbabilityLog = 0;
+            string topResult;
+            int topEd = engine->SegmentationPart(part, maxEditDistance, separatorLength, topResult, topProbabilityLog, counters);
+
+            // the first word of a text needs no separator
+            if (position == 0) separatorLength = 0;
+            long distanceSum = source->distanceSum + separatorLength + topEd;
+            double probabilityLogSum = source->probabilityLogSum + topProbabilityLog;
+            shared_ptr<Node>& destination = Slot(position + i);
+            // same rules as WordSegmentation; a slot is written unconditionally the first time
+            if (i == maxLength || !destination || destination->end != position + i
+                || (((source->distanceSum + topEd == destination->distanceSum) || (distanceSum == destination->distanceSum)) && (destination->probabilityLogSum < probabilityLogSum))
+                || (distanceSum < destination->distanceSum))
+            {
+                shared_ptr<Node> node = std::make_shared<Node>();
+                node->parent = source;
+                node->end = position + i;
+                node->segmented = part;
+                node->corrected = topResult;
+                node->distanceSum = distanceSum;
+                node->probabilityLogSum = probabilityLogSum;
+                destination = node;
+            }
+        }
+        ++position;
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Commit()
+    {
+        size_t maxLength = window.size();
+        size_t end = offset + text.size();
+        if (position - committed->end > maxPendingLength)
+        {
+            // no agreement for too long: keep the best composition ending here, drop the ones not extending it
+            shared_ptr<Node> target = Slot(position);
+            Emit(target);
+            for (size_t e = position + 1; e < position + maxLength && e <= end; ++e)
+            {
+                shared_ptr<Node>& slot = Slot(e);
+                if (!slot || slot->end != e) continue;
+                Node* node = slot.get();
+                while (node->end > target->end) node = node->parent.get();
+                if (node != target.get()) slot.reset();
+            }
+            return;
+        }
+
+        // last node shared by the compositions that can still be extended
+        Node* shared = nullptr;
+        for (size_t e = position; e < position + maxLength && e <= end; ++e)
+        {
+            const shared_ptr<Node>& slot = Slot(e);
+            if (!slot || slot->end != e) continue;
+            Node* node = slot.get();
+            if (shared == nullptr)
+            {
+                shared = node;
+                continue;
+            }
+            while (shared != node)
+            {
+                if (shared->end >= node->end) shared = shared->parent.get();
+                else node = node->parent.get();
+            }
+            if (shared == committed.get()) return;
+        }
+        if (shared == nullptr || shared == committed.get()) return;
+        // the shared node is owned by its descendants: find the owning pointer through one of them
+        shared_ptr<Node> owner = Slot(position);
+        while (owner.get() != shared) owner = owner->parent;
+        Emit(owner);
+    }
+
+    template <typename Engine>
+    void BasicStreamingSegmenter<Engine>::Emit(const shared_ptr<Node>& node)
+    {
+        vector<Node*> words;
+        for (Node* n = node.get(); n != committed.get(); n = n->parent.get()) words.push_back(n);
+        for (size_t i = words.size(); i-- > 0;)
+        {
+            if (emitted)
+            {
+                segmentedOut += ' ';
+                correctedOut += ' ';
+            }
+            segmentedOut += words[i]->segmented;
+            correctedOut += words[i]->corrected;
+            emitted = true;
+        }
+        committed = node;
+        // the words before it are out: free them, iteratively so long chains do not recurse
+        shared_ptr<Node> chain = std::move(committed->parent);
+        while (chain && chain.use_count() == 1) chain = std::move(chain->parent);
+        string().swap(committed->segmented);
+        string().swap(committed->corrected);
+    }
+
+    template class BasicStreamingSegmenter<BasicSymSpell<StdMapPolicy>>;
+    template class BasicStreamingSegmenter<BasicSymSpell<FlatMapPolicy>>;
+    template class BasicStreamingSegmenter<BasicSymSpell<ArenaMapPolicy>>;
+}
@@ -4,18 +4,26 @@
 
 namespace symspell {
 
-    SuggestionStage::SuggestionStage(size_t initialCapacity)
+    template <typename MapPolicy>
+    BasicSuggestionStage<MapPolicy>::BasicSuggestionStage(size_t initialCapacity, MonotonicArena* arena)
+        : Nodes(MapPolicy::template MakeAllocator<StageNode>(arena))
     {
+        if (MapPolicy::usesArena != (arena != nullptr)) throw std::invalid_argument("arena");
+        this->arena = arena;
+        Deletes = MapPolicy::template MakeTable<EntryMap>(arena);
         Deletes.reserve(initialCapacity);
         Nodes.Reserve(initialCapacity * 2);
+        DeletesEnd = Deletes.end();
     }
-    void SuggestionStage::Clear()
+    template <typename MapPolicy>
+    void BasicSuggestionStage<MapPolicy>::Clear()
     {
         Deletes.clear();
         Nodes.Clear();
         DeletesEnd = Deletes.end();
     }
-    void SuggestionStage::Add(size_t deleteHash, string suggestion)
+    template <typename MapPolicy>
+    void BasicSuggestionStage<MapPolicy>::Add(size_t deleteHash, string suggestion)
     {
         auto deletesFinded = Deletes.find(deleteHash);
 //        Entry* entry = nullptr;
@@ -32,48 +40,41 @@ namespace symspell {
         ++entry.count;
         entry.first = Nodes.Count;
         Deletes[deleteHash] = entry;
-        Node item;
+        StageNode item;
         item.next = next;
-        item.suggestion = suggestion;
-        Nodes.Add(item);
+        item.suggestion = MapPolicy::MakeString(suggestion, arena);
+        Nodes.Add(std::move(item));
     }
-    void SuggestionStage::CommitTo(unordered_map< size_t, vector< string > >& permanentDeletes)
+    template <typename MapPolicy>
+    void BasicSuggestionStage<MapPolicy>::CommitTo(DeletesMap& permanentDeletes)
     {
-        auto permanentDeletesEnd = permanentDeletes.end();
         for (auto it = Deletes.begin(); it != DeletesEnd; ++it)
         {
-            auto permanentDeletesFinded = permanentDeletes.find(it->first);
-//             vector<string>* suggestions = nullptr;
-            vector<string> suggestions;
-            size_t i;
-            if (permanentDeletesFinded != permanentDeletesEnd)
-            {
-                suggestions = permanentDeletesFinded->second;
-                i = suggestions.size();
-                vector<string> newSuggestions;
-                newSuggestions.reserve(suggestions.size() + it->second.count);
-
-                std::copy(suggestions.begin(), suggestions.end(), back_inserter(newSuggestions));
-                permanentDeletes[it->first] = newSuggestions;
-            }
-            else
-            {
-                i = 0;
-//                 suggestions = new vector<string>;
-                int32_t count = it->second.count;
-                suggestions.reserve(count);
-                permanentDeletes[it->first] = suggestions;
-            }
-
-            int next = it->second.first;
+            // a new bucket is constructed with the map's allocator, so with an arena it lands in the arena
+            typename MapPolicy::Bucket& suggestions = permanentDeletes[it->first];
+            suggestions.reserve(suggestions.size() + it->second.count);
+            long next = it->second.first;
             while (next >= 0)
             {
-                auto node = Nodes.at(next);
-                suggestions[i] = node.suggestion;
+                const StageNode& node = Nodes.at(next);
+                suggestions.push_back(node.suggestion);
                 next = node.next;
-                ++i;
             }
         }
     }
 
-}
\ No newline at end of file
+    template <typename MapPolicy>
+    size_t BasicSuggestionStage<MapPolicy>::MemoryUsage()
+    {
+        size_t bytes = MapPolicy::TableBytes(Deletes);
+        for (size_t row = 0; row < Nodes.Values.size(); ++row)
+            bytes += Nodes.Values[row].capacity() * sizeof(StageNode);
+        for (size_t i = 0; i < Nodes.Count; ++i)
+            bytes += MapPolicy::StringBytes(Nodes.at(i).suggestion);
+        return bytes;
+    }
+
+    template class BasicSuggestionStage<StdMapPolicy>;
+    template class BasicSuggestionStage<FlatMapPolicy>;
+    template class BasicSuggestionStage<ArenaMapPolicy>;
+}
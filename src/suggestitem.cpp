@@ -24,11 +24,11 @@ namespace symspell {
   
     bool SuggestItem::CompareTo(SuggestItem const& other)
     {
-        // order by distance ascending, then by frequency count descending
+        // order by distance ascending, then by frequency count descending, then by term
         if (this->distance == other.distance)
         {
             if (other.count == this->count)
-                return false;
+                return other.term.compare(this->term) < 0;
             else if (other.count > this->count)
                 return true;
             return false;
@@ -2,14 +2,21 @@
 
 namespace symspell {
 
-    SymSpell::SymSpell(int initialCapacity, int maxDictionaryEditDistance, int prefixLength, int countThreshold, int compactLevel)
+    template <typename MapPolicy>
+    BasicSymSpell<MapPolicy>::BasicSymSpell(int initialCapacity, int maxDictionaryEditDistance, int prefixLength, int countThreshold, int compactLevel, MonotonicArena* arena)
     {
         if (initialCapacity < 0) throw std::invalid_argument("initialCapacity");
         if (maxDictionaryEditDistance < 0) throw std::invalid_argument("maxDictionaryEditDistance");
         if (prefixLength < 1 || prefixLength <= maxDictionaryEditDistance) throw std::invalid_argument("prefixLength");
         if (countThreshold < 0) throw std::invalid_argument("countThreshold");
         if (compactLevel > 16) throw std::invalid_argument("compactLevel");
+        if (MapPolicy::usesArena != (arena != nullptr)) throw std::invalid_argument("arena");
 
+        this->arena = arena;
+        this->words = MapPolicy::template MakeTable<WordsMap>(arena);
+        this->deletes = MapPolicy::template MakeTable<DeletesMap>(arena);
+        this->belowThresholdWords = MapPolicy::template MakeTable<WordsMap>(arena);
+        this->surfaceForms = MapPolicy::template MakeTable<SurfaceMap>(arena);
         this->words.reserve(initialCapacity);
         this->deletes.reserve(initialCapacity);
         this->initialCapacity = initialCapacity;
@@ -23,11 +30,13 @@ namespace symspell {
         this->deletesEnd = this->deletes.end();
         this->wordsEnd = this->words.end();
         this->belowThresholdWordsEnd = this->belowThresholdWords.end();
-        this->candidates.reserve(32);
-        //this->maxDictionaryWordLength = 0;
+        this->surfaceFormsEnd = this->surfaceForms.end();
+        this->maxDictionaryWordLength = 0;
+        SelectKernel();
     }
 
-    SymSpell::~SymSpell()
+    template <typename MapPolicy>
+    BasicSymSpell<MapPolicy>::~BasicSymSpell()
     {
         vector<string>::iterator vecEnd;
 //         auto deletesEnd = this->deletes.end();
@@ -43,14 +52,25 @@ namespace symspell {
         delete this->distanceComparer;
     }
 
-    bool SymSpell::CreateDictionaryEntry(string key, long count, SuggestionStage * staging)
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::CreateDictionaryEntry(string key, long count, Stage * staging)
     {
-        int keyLen = (int)key.size();
         if (count <= 0)
         {
             if (this->countThreshold > 0) return false; // no point doing anything if count is zero, as it can't change anything
             count = 0;
         }
+        if (termsCompacted) throw std::logic_error("CreateDictionaryEntry after CompactTerms");
+        // the frozen table cannot take new words or counts; lookups use words until FreezeWords is called again
+        if (!knownWords.Empty()) knownWords.Clear();
+        bucketsSorted = false;
+        if (normalizer.Enabled())
+        {
+            string surface = key;
+            key = normalizer.Fold(surface);
+            RecordSurfaceForm(key, surface, count);
+        }
+        int keyLen = (int)key.size();
 
         long countPrevious = -1;
         auto belowThresholdWordsFinded = belowThresholdWords.find(key);
@@ -117,19 +137,68 @@ namespace symspell {
                 string tmp=key.substr(0,keyLen);
                 if (deletesFinded == deletesEnd)
                 {
-                    deletes[deleteHash] = vector<string>();
+                    deletes[deleteHash];
+                    if (!deleteFilter.Empty()) deleteFilter.Insert(deleteHash);
                 }
-                deletes[deleteHash].push_back(tmp);
+                deletes[deleteHash].emplace_back(tmp.data(), tmp.size());
                 deletesEnd = deletes.end();
             }
+            if (deleteFilter.Overloaded()) BuildDeleteFilter(deleteFilter.BitsPerKey());
         }
 
         edits.clear();
         return true;
     }
 
-    void SymSpell::EditsPrefix(string key, unordered_set<size_t>& hashSet)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::RecordSurfaceForm(const string& key, const string& surface, long count)
+    {
+        // keep the spelling with the highest single entry count
+        auto surfaceFormsFinded = surfaceForms.find(key);
+        if (surfaceFormsFinded != surfaceFormsEnd)
+        {
+            if (count > surfaceFormsFinded->second.second) surfaceFormsFinded->second = make_pair(surface, count);
+            return;
+        }
+        if (surface == key) return;
+
+        // the folded spelling itself may already be in the dictionary, with the count of its plain entries
+        long existing = -1;
+        auto wordsFinded = words.find(key);
+        auto belowThresholdWordsFinded = belowThresholdWords.find(key);
+        if (wordsFinded != wordsEnd) existing = wordsFinded->second;
+        else if (belowThresholdWordsFinded != belowThresholdWordsEnd) existing = belowThresholdWordsFinded->second;
+        if (count > existing)
+        {
+            surfaceForms[key] = make_pair(surface, count);
+            surfaceFormsEnd = surfaceForms.end();
+        }
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::ToSurfaceForms(const string& input, int maxEditDistance, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions)
+    {
+        for (size_t i = 0; i < suggestions.size(); ++i)
+        {
+            // the unknown input item carries the folded input
+            if (suggestions[i]->distance > maxEditDistance)
+            {
+                suggestions[i]->term = input;
+                continue;
+            }
+            auto surfaceFormsFinded = surfaceForms.find(suggestions[i]->term);
+            if (surfaceFormsFinded != surfaceFormsEnd) suggestions[i]->term = surfaceFormsFinded->second.first;
+        }
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::EditsPrefix(string key, HashSet& hashSet)
     {
+        if (editsFunction != nullptr)
+        {
+            (this->*editsFunction)(key, hashSet);
+            return;
+        }
         int len = (int)key.size();
         string tmp;
         /*if (len <= maxDictionaryEditDistance) //todo fix
@@ -154,7 +223,8 @@ namespace symspell {
         Edits(tmp, 0, hashSet);
     }
 
-    void SymSpell::Edits(string word, int editDistance, unordered_set<size_t> & deleteWords)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::Edits(string word, int editDistance, HashSet & deleteWords)
     {
         auto deleteWordsEnd = deleteWords.end();
         ++editDistance;
@@ -184,44 +254,253 @@ namespace symspell {
         }
     }
 
-    void SymSpell::PurgeBelowThresholdWords()
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::PurgeBelowThresholdWords()
     {
         belowThresholdWords.clear();
         belowThresholdWordsEnd = belowThresholdWords.end();
     }
 
-    void SymSpell::CommitStaged(SuggestionStage staging)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::CommitStaged(Stage staging)
     {
         staging.CommitTo(deletes);
+        deletesEnd = deletes.end();
+        bucketsSorted = false;
+        if (!deleteFilter.Empty()) BuildDeleteFilter(deleteFilter.BitsPerKey());
     }
 
-    void SymSpell::Lookup(string& input, Verbosity verbosity, vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::Lookup(string& input, Verbosity verbosity, vector<std::unique_ptr<symspell::SuggestItem>> & items)
     {
         this->Lookup(input, verbosity, this->maxDictionaryEditDistance, false, items);
     }
 
-    void SymSpell::Lookup(string& input, Verbosity verbosity, int maxEditDistance, vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::Lookup(string& input, Verbosity verbosity, int maxEditDistance, vector<std::unique_ptr<symspell::SuggestItem>> & items)
     {
         this->Lookup(input, verbosity, maxEditDistance, false, items);
     }
 
-    void SymSpell::Lookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::Lookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats* stats)
+    {
+        BoundedLookup(input, verbosity, maxEditDistance, includeUnknown, suggestions, stats, nullptr);
+    }
+
+    template <typename MapPolicy>
+    LookupStatus BasicSymSpell<MapPolicy>::Lookup(string& input, Verbosity verbosity, int maxEditDistance, const LookupOptions& options, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats* stats)
+    {
+        // checked before the table lowers it, so an invalid distance is rejected for inputs of any length
+        if (maxEditDistance > MaxDictionaryEditDistance()) throw std::invalid_argument("maxEditDistance");
+        // the lowered distance also bounds the deletes generated from input, so short inputs cost less
+        maxEditDistance = options.maxEditDistanceByLength.For(input, maxEditDistance);
+        LookupBudget budget(options);
+        bool complete = BoundedLookup(input, verbosity, maxEditDistance, options.includeUnknown, suggestions, stats, &budget);
+        return complete ? LookupStatus::Complete : LookupStatus::Truncated;
+    }
+
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::BoundedLookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats* stats, LookupBudget* budget)
+    {
+        // maxEditDistance used in Lookup can't be bigger than the maxDictionaryEditDistance
+        // used to construct the underlying dictionary structure.
+        if (maxEditDistance > MaxDictionaryEditDistance())  throw std::invalid_argument("maxEditDistance");
+
+#ifdef SYMSPELL_STATS
+        LookupStats counters;
+#else
+        // nothing writes counters without SYMSPELL_STATS, so every lookup can share one; stats is not written either
+        static LookupStats counters;
+        (void)stats;
+#endif
+        if (normalizer.Enabled())
+        {
+            string folded = normalizer.Fold(input);
+            (this->*lookupFunction)(folded, verbosity, maxEditDistance, includeUnknown, suggestions, counters, budget);
+            ToSurfaceForms(input, maxEditDistance, suggestions);
+        }
+        else
+            (this->*lookupFunction)(input, verbosity, maxEditDistance, includeUnknown, suggestions, counters, budget);
+        bool complete = budget == nullptr || !budget->Exhausted();
+#ifdef SYMSPELL_STATS
+        counters.lookups = 1;
+        if (!complete) counters.truncated = 1;
+        LookupStatsRegistry::Accumulate(counters);
+        if (stats != nullptr) *stats = counters;
+#endif
+        return complete;
+    }
+
+    // Candidates of DoLookup as the constructor parameters ask for: breadth first deletes of the input prefix,
+    // deduplicated by hash, and the distance of the EditDistance comparer.
+    template <typename MapPolicy>
+    struct BasicSymSpell<MapPolicy>::RuntimeKernel
+    {
+        const BasicSymSpell& engine;
+        vector<string>& candidates;
+        HashSet& hashset1;
+        size_t next = 0;
+
+        RuntimeKernel(const BasicSymSpell& engine, LookupScratch& scratch) : engine(engine), candidates(scratch.candidates), hashset1(scratch.hashset1)
+        {
+            candidates.reserve(32);
+        }
+
+        int PrefixLength() const { return engine.prefixLength; }
+        void Start(const string& input, int inputPrefixLen, int)
+        {
+            candidates.push_back(input.substr(0, inputPrefixLen));
+        }
+        bool Next(string& candidate, size_t& hash)
+        {
+            if (next == candidates.size()) return false;
+            candidate = candidates[next++];
+            hash = engine.stringHash(candidate);
+            return true;
+        }
+        void Expand(const string& candidate)
+        {
+            int candidateLen = (int)candidate.size();
+            for (int i = 0; i < candidateLen; ++i)
+            {
+                string tmp;
+                tmp = candidate.substr(0,i);
+                tmp += candidate.substr( i + 1,candidateLen - 1 - i);
+                if (hashset1.insert(engine.stringHash(tmp)).second) candidates.push_back(tmp);
+            }
+        }
+        int Distance(const string& input, const string& suggestion, int maxDistance) { return engine.distanceComparer->Compare(input, suggestion, maxDistance); }
+        size_t Generated() const { return candidates.size(); }
+        void Clear()
+        {
+            candidates.clear();
+            hashset1.clear();
+        }
+    };
+
+    // Candidates of DoLookup for compile time parameters: the deletes come from the DeleteMasks table in
+    // breadth first order and are built in stack buffers, deduplicated against a stack array of hashes,
+    // and the distance policy is inlined.
+    template <typename MapPolicy>
+    template <int MaxEd, int PrefixLen, typename DistancePolicy>
+    struct BasicSymSpell<MapPolicy>::FixedKernel
+    {
+        typedef DeleteMasks<PrefixLen, MaxEd> Masks;
+
+        uint64_t seed;
+        char prefix[PrefixLen];
+        int prefixLen = 0;
+        int maxEditDistance = 0;
+        size_t next = 0;
+        size_t generated = 0;
+        uint64_t seen[Masks::Count];
+
+        FixedKernel(const BasicSymSpell& engine, LookupScratch&) : seed(engine.stringHash.seed) { }
+
+        static constexpr int PrefixLength() { return PrefixLen; }
+        void Start(const string& input, int inputPrefixLen, int maxEditDistance)
+        {
+            std::memcpy(prefix, input.data(), inputPrefixLen);
+            prefixLen = inputPrefixLen;
+            this->maxEditDistance = maxEditDistance;
+        }
+        bool Next(string& candidate, size_t& hash)
+        {
+            const uint32_t* masks = Masks::Masks();
+            const uint8_t* sizes = Masks::Sizes();
+            for (; next < Masks::Count && sizes[next] <= maxEditDistance; ++next)
+            {
+                uint32_t mask = masks[next];
+                // deletes beyond a short input
+                if (mask >> prefixLen) continue;
+                char buffer[PrefixLen];
+                int length = 0;
+                for (int i = 0; i < prefixLen; ++i)
+                    if (!((mask >> i) & 1)) buffer[length++] = prefix[i];
+                uint64_t deleteHash = hash64(buffer, length, seed);
+                if (std::find(seen, seen + generated, deleteHash) != seen + generated) continue;
+                seen[generated++] = deleteHash;
+                ++next;
+                candidate.assign(buffer, length);
+                hash = (size_t)deleteHash;
+                return true;
+            }
+            return false;
+        }
+        void Expand(const string&) { }
+        int Distance(const string& input, const string& suggestion, int maxDistance) { return DistancePolicy::Distance(input, suggestion, maxDistance); }
+        size_t Generated() const { return generated; }
+        void Clear() { }
+    };
+
+    template <typename MapPolicy>
+    template <int MaxEd, int PrefixLen>
+    void BasicSymSpell<MapPolicy>::FixedEditsPrefix(string key, HashSet& hashSet)
+    {
+        typedef DeleteMasks<PrefixLen, MaxEd> Masks;
+        const uint32_t* masks = Masks::Masks();
+        const uint8_t* sizes = Masks::Sizes();
+        int len = min((int)key.size(), PrefixLen);
+        char buffer[PrefixLen];
+        for (size_t m = 0; m < Masks::Count; ++m)
+        {
+            // Edits stops deleting at one character left
+            if ((masks[m] >> len) || (sizes[m] > 0 && len - sizes[m] < 1)) continue;
+            int length = 0;
+            for (int i = 0; i < len; ++i)
+                if (!((masks[m] >> i) & 1)) buffer[length++] = key[i];
+            hashSet.insert((size_t)hash64(buffer, length, stringHash.seed));
+        }
+    }
+
+    template <typename MapPolicy>
+    template <int MaxEd, int PrefixLen, typename DistancePolicy>
+    void BasicSymSpell<MapPolicy>::UseFixedKernel()
+    {
+        lookupFunction = &BasicSymSpell::template DoLookup<FixedKernel<MaxEd, PrefixLen, DistancePolicy>>;
+        editsFunction = &BasicSymSpell::template FixedEditsPrefix<MaxEd, PrefixLen>;
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::SelectKernel()
+    {
+        lookupFunction = &BasicSymSpell::template DoLookup<RuntimeKernel>;
+        editsFunction = nullptr;
+        if (!fixedKernels) return;
+        // keep in step with the HasFixedKernel specializations in symspell.h
+        typedef EditDistance::DistanceAlgorithm Algorithm;
+        int maxEd = maxDictionaryEditDistance;
+        if (prefixLength == 7 && distanceAlgorithm == Algorithm::DamerauOSA)
+        {
+            if (maxEd == 1) UseFixedKernel<1, 7, OsaDistance>();
+            else if (maxEd == 2) UseFixedKernel<2, 7, OsaDistance>();
+            else if (maxEd == 3) UseFixedKernel<3, 7, OsaDistance>();
+        }
+        else if (distanceAlgorithm == Algorithm::Levenshtein)
+        {
+            if (prefixLength == 5 && maxEd == 1) UseFixedKernel<1, 5, LevenshteinDistance>();
+            else if (prefixLength == 7 && maxEd == 2) UseFixedKernel<2, 7, LevenshteinDistance>();
+        }
+    }
+
+    template <typename MapPolicy>
+    template <typename Kernel>
+    void BasicSymSpell<MapPolicy>::DoLookup(string& input, Verbosity verbosity, int maxEditDistance, bool includeUnknown, vector<std::unique_ptr<symspell::SuggestItem>> & suggestions, LookupStats& counters, LookupBudget* budget)
     {
-        mtx.lock();
+        // scratch containers are per thread, so concurrent lookups share nothing mutable
+        static thread_local LookupScratch scratch;
+        HashSet& hashset2 = scratch.hashset2;
+        Kernel kernel(*this, scratch);
         suggestions.clear();
-        edits.clear();
-        candidates.reserve(32);
 
         //verbosity=Top: the suggestion with the highest term frequency of the suggestions of smallest edit distance found
         //verbosity=Closest: all suggestions of smallest edit distance found, the suggestions are ordered by term frequency
         //verbosity=All: all suggestions <= maxEditDistance, the suggestions are ordered by edit distance, then by term frequency (slower, no early termination)
 
-        // maxEditDistance used in Lookup can't be bigger than the maxDictionaryEditDistance
-        // used to construct the underlying dictionary structure.
-        if (maxEditDistance > MaxDictionaryEditDistance())  throw std::invalid_argument("maxEditDistance");
         long suggestionCount = 0;
         size_t suggestionsLen = 0;
-        auto wordsFinded = words.find(input);
+        bool inputKnown = FindWord(input, suggestionCount);
         int inputLen = (int)input.size();
         // early exit - word is too big to possibly match any words
         if (inputLen - maxEditDistance > maxDictionaryWordLength)
@@ -232,15 +511,14 @@ namespace symspell {
                 suggestions.push_back(std::move(unq));
             }
 
-            mtx.unlock();
+            SYMSPELL_STAT_ADD(counters, earlyExits, 1);
             return;
         }
 
         // quick look for exact match
 
-        if (wordsFinded != wordsEnd)
+        if (inputKnown)
         {
-            suggestionCount = wordsFinded->second;
             {
                 std::unique_ptr<SuggestItem> unq(new SuggestItem(input, 0, suggestionCount));
                 suggestions.push_back(std::move(unq));
@@ -257,8 +535,8 @@ namespace symspell {
                     ++suggestionsLen;
                 }
 
-                mtx.unlock();
-                return;
+                SYMSPELL_STAT_ADD(counters, earlyExits, 1);
+                    return;
             }
         }
 
@@ -273,7 +551,7 @@ namespace symspell {
                 ++suggestionsLen;
             }
 
-            mtx.unlock();
+            SYMSPELL_STAT_ADD(counters, earlyExits, 1);
             return;
         }
 
@@ -281,27 +559,19 @@ namespace symspell {
         hashset2.insert(stringHash(input));
 
         int maxEditDistance2 = maxEditDistance;
-        int candidatePointer = 0;
 
         //add original prefix
-        int inputPrefixLen = inputLen;
-        if (inputPrefixLen > prefixLength)
-        {
-            inputPrefixLen = prefixLength;
-            candidates.push_back(input.substr(0,inputPrefixLen));
-        }
-        else
-        {
-            candidates.push_back(input);
-        }
+        int inputPrefixLen = min(inputLen, kernel.PrefixLength());
+        kernel.Start(input, inputPrefixLen, maxEditDistance);
 
-        size_t candidatesLen = 1; // candidates.size();
-        while (candidatePointer < candidatesLen)
+        string candidate;
+        size_t candidateHash;
+        while (kernel.Next(candidate, candidateHash))
         {
-            string candidate = candidates[candidatePointer];
+            // out of budget: keep what was found so far
+            if (budget != nullptr && !budget->Candidate()) break;
             int candidateLen = (int)candidate.size();
             int lengthDiff = inputPrefixLen - candidateLen;
-            candidatePointer++;
 
             //save some time - early termination
             //if canddate distance is already higher than suggestion distance, than there are no better suggestions to be expected
@@ -310,29 +580,90 @@ namespace symspell {
                 // skip to next candidate if Verbosity.All, look no further if Verbosity.Top or Closest
                 // (candidates are ordered by delete distance, so none are closer than current)
                 if (verbosity == Verbosity::All) continue;
+                SYMSPELL_STAT_ADD(counters, earlyExits, 1);
                 break;
             }
 
-            auto deletesFinded = deletes.find(stringHash(candidate));
-            vector<string> dictSuggestions;
+            // most candidates are in no bucket: the filter rules them out without touching deletes
+            auto deletesFinded = deletesEnd;
+            if (deleteFilter.MayContain(candidateHash))
+            {
+                deletesFinded = deletes.find(candidateHash);
+                SYMSPELL_STAT_ADD(counters, bucketsProbed, 1);
+            }
+            else SYMSPELL_STAT_ADD(counters, filterRejected, 1);
 
             //read candidate entry from dictionary
             if (deletesFinded != deletesEnd)
             {
-                dictSuggestions = deletesFinded->second;
+                SYMSPELL_STAT_ADD(counters, bucketsHit, 1);
+                const Bucket& dictSuggestions = deletesFinded->second;
                 size_t dictSuggestionsLen = dictSuggestions.size();
+                size_t firstSuggestion = 0;
+                if (bucketsSorted && dictSuggestionsLen > 4)
+                {
+                    // sorted by length: start at the first entry that is neither a collision (shorter than the candidate) nor too short
+                    size_t minLen = (size_t)max(candidateLen, inputLen - maxEditDistance2);
+                    firstSuggestion = std::lower_bound(dictSuggestions.begin(), dictSuggestions.end(), minLen, [](const typename MapPolicy::String& s, size_t len)
+                    {
+                        return s.size() < len;
+                    }) - dictSuggestions.begin();
+                    SYMSPELL_STAT_ADD(counters, entriesSkipped, firstSuggestion);
+                }
                 //iterate through suggestions (to other correct dictionary items) of delete item and add them to suggestion list
-                for (int i = 0; i < dictSuggestionsLen; ++i)
+                for (size_t i = firstSuggestion; i < dictSuggestionsLen; ++i)
                 {
-                    string suggestion = dictSuggestions.at(i);
+                    if (budget != nullptr && !budget->Entry()) break;
+                    const string& suggestion = AsStdString(dictSuggestions[i], scratch.suggestion);
                     int suggestionLen = (int)suggestion.size();
-                    if (suggestion.compare(input) == 0) continue;
-                    if ((abs(suggestionLen - inputLen) > maxEditDistance2) // input and sugg lengths diff > allowed/current best distance
-                        || (suggestionLen < candidateLen) // sugg must be for a different delete string, in same bin only because of hash collision
+                    if (bucketsSorted)
+                    {
+                        // the remaining entries are at least as long: none is within the current best distance
+                        if (suggestionLen > inputLen + maxEditDistance2)
+                        {
+                            SYMSPELL_STAT_ADD(counters, entriesSkipped, dictSuggestionsLen - i);
+                            break;
+                        }
+                        // Top: when no entry of this length can be closer than the best suggestion, only a more frequent one
+                        // (or an equally frequent, smaller term) can replace it, and entries of one length come by descending
+                        // count, then by term
+                        if (verbosity == Verbosity::Top && suggestionsLen > 0 && max(1, abs(suggestionLen - inputLen)) >= maxEditDistance2)
+                        {
+                            long count = 0;
+                            FindWord(suggestion, count);
+                            if (count < suggestions[0]->count || (count == suggestions[0]->count && suggestion.compare(suggestions[0]->term) >= 0))
+                            {
+                                size_t next = i + 1;
+                                while (next < dictSuggestionsLen && (int)dictSuggestions[next].size() == suggestionLen) ++next;
+                                SYMSPELL_STAT_ADD(counters, entriesSkipped, next - i);
+                                i = next - 1;
+                                continue;
+                            }
+                        }
+                    }
+                    SYMSPELL_STAT_ADD(counters, entriesScanned, 1);
+                    if (suggestion.compare(input) == 0)
+                    {
+                        SYMSPELL_STAT_ADD(counters, rejectedExact, 1);
+                        continue;
+                    }
+                    if (abs(suggestionLen - inputLen) > maxEditDistance2) // input and sugg lengths diff > allowed/current best distance
+                    {
+                        SYMSPELL_STAT_ADD(counters, rejectedLength, 1);
+                        continue;
+                    }
+                    if ((suggestionLen < candidateLen) // sugg must be for a different delete string, in same bin only because of hash collision
                         || (suggestionLen == candidateLen && suggestion.compare(candidate) != 0)) // if sugg len = delete len, then it either equals delete or is in same bin only because of hash collision
+                    {
+                        SYMSPELL_STAT_ADD(counters, rejectedCollision, 1);
+                        continue;
+                    }
+                    auto suggPrefixLen = min(suggestionLen, kernel.PrefixLength());
+                    if (suggPrefixLen > inputPrefixLen && (suggPrefixLen - candidateLen) > maxEditDistance2)
+                    {
+                        SYMSPELL_STAT_ADD(counters, rejectedPrefixLength, 1);
                         continue;
-                    auto suggPrefixLen = min(suggestionLen, prefixLength);
-                    if (suggPrefixLen > inputPrefixLen && (suggPrefixLen - candidateLen) > maxEditDistance2) continue;
+                    }
 
                     //True Damerau-Levenshtein Edit Distance: adjust distance, if both distances>0
                     //We allow simultaneous edits (deletes) of maxEditDistance on on both the dictionary and the input term.
@@ -347,42 +678,73 @@ namespace symspell {
                     {
                         //suggestions which have no common chars with input (inputLen<=maxEditDistance && suggestionLen<=maxEditDistance)
                         distance = max(inputLen, suggestionLen);
-                        if (distance > maxEditDistance2 || !hashset2.insert(stringHash(suggestion)).second)
+                        if (distance > maxEditDistance2)
+                        {
+                            SYMSPELL_STAT_ADD(counters, rejectedDistance, 1);
+                            continue;
+                        }
+                        if (!hashset2.insert(stringHash(suggestion)).second)
+                        {
+                            SYMSPELL_STAT_ADD(counters, rejectedDuplicate, 1);
                             continue;
+                        }
                     }
                     else if (suggestionLen == 1)
                     {
                         if (findCharLocation(input, suggestion[0]) < 0) distance = inputLen; else distance = inputLen - 1;
                         distance = max(inputLen, suggestionLen);
-                        if (distance > maxEditDistance2 || !hashset2.insert(stringHash(suggestion)).second)
+                        if (distance > maxEditDistance2)
+                        {
+                            SYMSPELL_STAT_ADD(counters, rejectedDistance, 1);
                             continue;
+                        }
+                        if (!hashset2.insert(stringHash(suggestion)).second)
+                        {
+                            SYMSPELL_STAT_ADD(counters, rejectedDuplicate, 1);
+                            continue;
+                        }
                     }
                     else
-                        if ((prefixLength - maxEditDistance == candidateLen)
+                        if ((kernel.PrefixLength() - maxEditDistance == candidateLen)
                             && (((_min = min(inputLen, suggestionLen) - prefixLength) > 1)
                                 && (input.substr(inputLen + 1 - _min) != suggestion.substr(suggestionLen + 1 - _min)) /*(input.substr(inputLen + 1 - _min) != suggestion.substr(suggestionLen + 1 - _min))*/)
                             || ((_min > 0) && (input[inputLen - _min] != suggestion[suggestionLen - _min])
                                 && ((input[inputLen - _min - 1] != suggestion[suggestionLen - _min])
                                     || (input[inputLen - _min] != suggestion[suggestionLen - _min - 1]))))
                         {
+                            SYMSPELL_STAT_ADD(counters, rejectedSuffix, 1);
                             continue;
                         }
                         else
                         {
-                            if ((verbosity != Verbosity::All && !DeleteInSuggestionPrefix(candidate, candidateLen, suggestion, suggestionLen)) ||
-                                !hashset2.insert(stringHash(suggestion)).second) continue;
+                            if (verbosity != Verbosity::All && !DeleteInSuggestionPrefix(candidate, candidateLen, suggestion, suggestionLen))
+                            {
+                                SYMSPELL_STAT_ADD(counters, rejectedDeleteInPrefix, 1);
+                                continue;
+                            }
+                            if (!hashset2.insert(stringHash(suggestion)).second)
+                            {
+                                SYMSPELL_STAT_ADD(counters, rejectedDuplicate, 1);
+                                continue;
+                            }
 
-                            distance = distanceComparer->Compare(input, suggestion, maxEditDistance2);
-                            if (distance < 0) continue;
+                            if (budget != nullptr && !budget->Distance()) break;
+                            SYMSPELL_STAT_ADD(counters, distanceComputations, 1);
+                            distance = kernel.Distance(input, suggestion, maxEditDistance2);
+                            if (distance < 0)
+                            {
+                                SYMSPELL_STAT_ADD(counters, rejectedDistance, 1);
+                                continue;
+                            }
                         }
 
-                    if (distance <= maxEditDistance2)
+                    if (distance > maxEditDistance2)
+                    {
+                        SYMSPELL_STAT_ADD(counters, rejectedDistance, 1);
+                    }
+                    else
                     {
-                        auto wordsFindedNew = words.find(suggestion);
-//                         if (wordsFindedNew != wordsEnd) cerr << wordsFindedNew->second<<endl;
-//                         else cerr << "Error, can't find " << suggestion << endl;
-                        
-                        suggestionCount = words[suggestion];
+                        if (!FindWord(suggestion, suggestionCount)) suggestionCount = 0;
 //                         cerr << "TEST HERE : " << "\t" << suggestion << "\t" << distance <<  "\t" << suggestionCount<< "\t" <<endl;
                         std::unique_ptr<SuggestItem> si(new SuggestItem(suggestion, distance, suggestionCount));
                         if (suggestionsLen > 0)
@@ -401,7 +763,9 @@ namespace symspell {
                             }
                             case Verbosity::Top:
                             {
-                                if (distance < maxEditDistance2 || suggestionCount > suggestions[0]->count)
+                                // ties on distance and count go to the smaller term, so the answer does not depend on bucket order
+                                if (distance < maxEditDistance2 || suggestionCount > suggestions[0]->count
+                                    || (suggestionCount == suggestions[0]->count && suggestion.compare(suggestions[0]->term) < 0))
                                 {
                                     maxEditDistance2 = distance;
                                     suggestions[0] = std::move(si);
@@ -420,36 +784,21 @@ namespace symspell {
                     }
                 }//end foreach
             }//end if
+            if (budget != nullptr && budget->Exhausted()) break;
 
             //add edits
             //derive edits (deletes) from candidate (input) and add them to candidates list
             //this is a recursive process until the maximum edit distance has been reached
-            if ((lengthDiff < maxEditDistance) && (candidateLen <= prefixLength))
+            if ((lengthDiff < maxEditDistance) && (candidateLen <= kernel.PrefixLength()))
             {
                 //save some time
                 //do not create edits with edit distance smaller than suggestions already found
                 if (verbosity != Verbosity::All && lengthDiff >= maxEditDistance2) continue;
 
-                for (int i = 0; i < candidateLen; ++i)
-                {
-                    string tmp; 
-                    tmp = candidate.substr(0,i);
-                    tmp += candidate.substr( i + 1,candidateLen - 1 - i);
-//                     char* tmp = new char[candidateLen];
-//                     std::memcpy(tmp, candidate, i);
-//                     std::memcpy(tmp + i, candidate + i + 1, candidateLen - 1 - i);
-//                     tmp[candidateLen - 1] = '\0';
-
-                    if (hashset1.insert(stringHash(tmp)).second)
-                    {
-                        candidates.push_back(tmp);
-                        ++candidatesLen;
-                    }
-                    else tmp.clear();
-//                         delete[] tmp;
-                }
+                kernel.Expand(candidate);
             }
         }//end while
+        SYMSPELL_STAT_ADD(counters, candidatesGenerated, kernel.Generated());
 
         //sort by ascending edit distance, then by descending word frequency
         if (suggestionsLen > 1)
@@ -458,25 +807,23 @@ namespace symspell {
             return r->CompareTo(*l);
         });
 
+        if (includeUnknown && (suggestionsLen == 0))
+        {
+            std::unique_ptr<SuggestItem> unq(new SuggestItem(input, maxEditDistance + 1, 0));
+            suggestions.push_back(std::move(unq));
+        }
 
         //cleaning
 
         //std::cout << hashset2.size() << std::endl;
 
-        auto candidatesEnd = candidates.end();
-//         for (auto it = candidates.begin(); it != candidatesEnd; ++it)
-//             delete[] * it;
-
-
-        candidates.clear();
-        hashset1.clear();
+        kernel.Clear();
         hashset2.clear();
 
-        mtx.unlock();
-
     }//end if
 
-    bool SymSpell::LoadDictionary(string corpus, int termIndex, int countIndex)
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::LoadDictionary(string corpus, int termIndex, int countIndex)
     {
         ifstream stream;
         int l_nb_lines_file = 0;
@@ -493,8 +840,6 @@ namespace symspell {
             stream.seekg(0);
         }
 
-        SuggestionStage staging(16384);
-
         string line;
         while (getline(stream, line))
         {
@@ -527,10 +872,27 @@ namespace symspell {
         stream.close();
         cerr << "Loaded " << l_nb_lines_loaded << "/" << l_nb_lines_file << " lines" <<endl;
 
+        FinishLoading();
+
+        return true;
+    }
+
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::BuildFromCorpus(const vector<string>& paths, size_t threads, size_t sketchWidth)
+    {
+        CorpusCounter counter(countThreshold, threads, sketchWidth);
+        if (!counter.Count(paths)) return false;
+        vector<pair<string, long>> counts = counter.Counts();
+        for (size_t i = 0; i < counts.size(); ++i) CreateDictionaryEntry(counts[i].first, counts[i].second);
+        cerr << "Counted " << counter.Tokens() << " words, " << counts.size() << " distinct" << endl;
+
+        FinishLoading();
+
         return true;
     }
 
-    void SymSpell::rempaceSpaces(string& source)
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::rempaceSpaces(string& source)
     {
         
         string cleaned_source;
@@ -541,18 +903,84 @@ namespace symspell {
         source=cleaned_source;
     }
 
-    shared_ptr<WordSegmentationItem> SymSpell::WordSegmentation(string& input)
+    template <typename MapPolicy>
+    int BasicSymSpell<MapPolicy>::SegmentationPart(string& part, size_t maxEditDistance, int& separatorLength, string& corrected, double& probabilityLog, LookupStats& counters)
+    {
+        int topEd = 0;
+        separatorLength = 0;
+        if (isspace(part[0]))
+        {
+            part = part.substr(1, part.size() - 1);
+        }
+        else
+        {
+            //add ed+1: space did not exist, had to be inserted
+            separatorLength = 1;
+        }
+
+        //remove space from part1, add number of removed spaces to topEd
+        topEd += (int)part.size();
+        //remove space
+        rempaceSpaces(part);
+        //add number of removed spaces to ed
+        topEd -= (int)part.size();
+        vector<std::unique_ptr<symspell::SuggestItem>> results;
+#ifdef SYMSPELL_STATS
+        LookupStats partStats;
+        Lookup(part, symspell::Verbosity::Top, maxEditDistance, false, results, &partStats);
+        counters += partStats;
+#else
+        Lookup(part, symspell::Verbosity::Top, maxEditDistance, false, results);
+#endif
+        SYMSPELL_STAT_ADD(counters, segmentationParts, 1);
+        if (results.size() > 0)
+        {
+            corrected = results[0]->term;
+            topEd += results[0]->distance;
+            //Naive Bayes Rule
+            //we assume the word probabilities of two words to be independent
+            //therefore the resulting probability of the word combination is the product of the two word probabilities
+
+            //instead of computing the product of probabilities we are computing the sum of the logarithm of probabilities
+            //because the probabilities of words are about 10^-10, the product of many such small numbers could exceed (underflow) the floating number range and become zero
+            //log(ab)=log(a)+log(b)
+            // quantized counts come with their log10 precomputed (see countquantizer.h)
+            double log10Count = 0;
+            if (knownWords.Quantized() && knownWords.FindLog10(results[0]->term, log10Count)) probabilityLog = log10Count - log10N;
+            else probabilityLog = (double)log10((double)results[0]->count / (double)N);
+        }
+        else
+        {
+            corrected = part;
+            //default, if word not found
+            //otherwise long input text would win as long unknown word (with ed=edmax+1 ), although there there should many spaces inserted
+            topEd += (int)part.size();
+            probabilityLog = (double)log10(10.0 / (N * pow(10.0, (float)part.size())));
+        }
+        return topEd;
+    }
+
+    template <typename MapPolicy>
+    shared_ptr<WordSegmentationItem> BasicSymSpell<MapPolicy>::WordSegmentation(string& input)
     {
         return WordSegmentation(input, this->maxDictionaryEditDistance, this->maxDictionaryWordLength);
     }
 
-    shared_ptr<WordSegmentationItem> SymSpell::WordSegmentation(string& input, size_t maxEditDistance)
+    template <typename MapPolicy>
+    shared_ptr<WordSegmentationItem> BasicSymSpell<MapPolicy>::WordSegmentation(string& input, size_t maxEditDistance)
     {
         return WordSegmentation(input, maxEditDistance, this->maxDictionaryWordLength);
     }
 
-    shared_ptr<WordSegmentationItem> SymSpell::WordSegmentation(string& input, size_t maxEditDistance, size_t maxSegmentationWordLength)
+    template <typename MapPolicy>
+    shared_ptr<WordSegmentationItem> BasicSymSpell<MapPolicy>::WordSegmentation(string& input, size_t maxEditDistance, size_t maxSegmentationWordLength, LookupStats* stats)
     {
+#ifdef SYMSPELL_STATS
+        LookupStats counters;
+#else
+        static LookupStats counters;
+        (void)stats;
+#endif
         size_t inputLen = (int)input.size();
         int arraySize = min(maxSegmentationWordLength, inputLen);
         std::vector<shared_ptr<WordSegmentationItem>> compositions;
@@ -573,68 +1001,10 @@ namespace symspell {
             for (int i = 1; i <= imax; ++i)
             {
                 string part = input.substr(j,i);
-//                 char* part = new char[i + 1];
-//                 std::memcpy(part, input + j, i);
-//                 part[i] = '\0';
-
                 int separatorLength = 0;
-                int topEd = 0;
                 double topProbabilityLog = 0;
                 string topResult;
-//                 char* topResult = nullptr;
-
-                if (isspace(part[0]))
-                {
-                    int partLen = (int)part.size();
-//                     char* tmp = new char[partLen];
-//                     std::memcpy(tmp, part + 1, partLen - 1);
-                    string tmp=part.substr(1,partLen - 1);
-//                     tmp[(i - j)] = '\0';
-
-//                     delete[] part;
-                    part = tmp;
-                }
-                else
-                {
-                    //add ed+1: space did not exist, had to be inserted
-                    separatorLength = 1;
-                }
-
-                //remove space from part1, add number of removed spaces to topEd
-                topEd += (int)part.size();
-                //remove space
-                rempaceSpaces(part);
-                //add number of removed spaces to ed
-                topEd -= (int)part.size();
-                vector<std::unique_ptr<symspell::SuggestItem>> results;
-                Lookup(part, symspell::Verbosity::Top, maxEditDistance, results);
-                if (results.size() > 0)
-                {
-                    int termLen = (int)results[0]->term.size();
-                    topResult = results[0]->term.substr(0,termLen);
-//                     topResult = new char[termLen + 1];
-//                     std::memcpy(topResult, results[0]->term, termLen);
-//                     topResult[termLen] = '\0';
-
-                    topEd += results[0]->distance;
-                    //Naive Bayes Rule
-                    //we assume the word probabilities of two words to be independent
-                    //therefore the resulting probability of the word combination is the product of the two word probabilities
-
-                    //instead of computing the product of probabilities we are computing the sum of the logarithm of probabilities
-                    //because the probabilities of words are about 10^-10, the product of many such small numbers could exceed (underflow) the floating number range and become zero
-                    //log(ab)=log(a)+log(b)
-                    topProbabilityLog = (double)log10((double)results[0]->count / (double)N);
-                }
-                else
-                {
-                    topResult.clear();
-                    topResult = part;
-                    //default, if word not found
-                    //otherwise long input text would win as long unknown word (with ed=edmax+1 ), although there there should many spaces inserted
-                    topEd += (int)part.size();
-                    topProbabilityLog = (double)log10(10.0 / (N * pow(10.0, (float)part.size())));
-                }
+                int topEd = SegmentationPart(part, maxEditDistance, separatorLength, topResult, topProbabilityLog, counters);
 
                 int destinationIndex = ((i + circularIndex) % arraySize);
 
@@ -663,8 +1033,8 @@ namespace symspell {
                     segmentedTmp +=" ";
                     segmentedTmp +=part;
                     string correctedTmp = corrected;
-                    segmentedTmp +=" ";
-                    segmentedTmp +=topResult;
+                    correctedTmp +=" ";
+                    correctedTmp +=topResult;
 //                     std::memcpy(segmentedTmp, segmented, segmentedLen);
 //                     std::memcpy(segmentedTmp + segmentedLen, " ", 1);
 //                     std::memcpy(segmentedTmp + segmentedLen + 1, part, partLen);
@@ -690,10 +1060,20 @@ namespace symspell {
             }
             ++circularIndex; if (circularIndex == arraySize) circularIndex = 0;
         }
+#ifdef SYMSPELL_STATS
+        // the part lookups are already in the registry, only add what segmentation itself counted
+        LookupStats segmentation;
+        segmentation.segmentations = 1;
+        segmentation.segmentationParts = counters.segmentationParts;
+        LookupStatsRegistry::Accumulate(segmentation);
+        counters.segmentations = 1;
+        if (stats != nullptr) *stats = counters;
+#endif
         return compositions[circularIndex];
     }
 
-    bool SymSpell::DeleteInSuggestionPrefix(string del, int deleteLen, string suggestion, int suggestionLen)
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::DeleteInSuggestionPrefix(const string& del, int deleteLen, const string& suggestion, int suggestionLen)
     {
         if (deleteLen == 0) return true;
         if (prefixLength < suggestionLen) suggestionLen = prefixLength;
@@ -706,4 +1086,304 @@ namespace symspell {
         }
         return true;
     }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::setNormalizer(const Normalizer& normalizer)
+    {
+        if (termsCompacted || !this->words.empty() || !this->belowThresholdWords.empty()) throw std::logic_error("setNormalizer");
+        this->normalizer = normalizer;
+        this->surfaceForms.clear();
+        this->surfaceFormsEnd = this->surfaceForms.end();
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::setHashSeed(uint64_t seed)
+    {
+        if (!this->deletes.empty()) throw std::logic_error("setHashSeed");
+        this->stringHash = hash_c_string(seed);
+    }
+
+    template <typename MapPolicy>
+    template <typename Visit>
+    void BasicSymSpell<MapPolicy>::ForEachWord(Visit visit)
+    {
+        if (!termsCompacted)
+        {
+            for (auto it = words.begin(); it != wordsEnd; ++it) visit(it->first, it->second);
+            return;
+        }
+        terms.ForEach([&](uint32_t, const string& term)
+        {
+            long count = 0;
+            knownWords.Find(term, &count);
+            visit(term, count);
+        });
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::CompactTerms(size_t blockSize)
+    {
+        if (termsCompacted) return;
+        if (knownWords.Empty()) FreezeWords();
+        vector<string> keys;
+        keys.reserve(words.size());
+        for (auto it = words.begin(); it != wordsEnd; ++it) keys.push_back(it->first);
+        terms = FrontCodedTermStore(blockSize);
+        terms.Build(keys);
+        // counts now live in knownWords only
+        words = MapPolicy::template MakeTable<WordsMap>(arena);
+        wordsEnd = words.end();
+        termsCompacted = true;
+    }
+
+    template <typename MapPolicy>
+    IndexDiagnostics BasicSymSpell<MapPolicy>::DiagnoseIndex()
+    {
+        // for every bucket hash: the distinct delete strings that map to it, and how many words generated each
+        unordered_map<size_t, vector<pair<string, size_t>>> origins;
+        unordered_set<string> deleteStrings;
+        ForEachWord([&](const string& key, long)
+        {
+            string prefix = key.substr(0, min((int)key.size(), prefixLength));
+            deleteStrings.clear();
+            deleteStrings.insert(prefix);
+            DeleteStrings(prefix, 0, deleteStrings);
+            for (auto del = deleteStrings.begin(); del != deleteStrings.end(); ++del)
+            {
+                vector<pair<string, size_t>>& strings = origins[stringHash(*del)];
+                size_t i = 0;
+                while (i < strings.size() && strings[i].first != *del) ++i;
+                if (i == strings.size()) strings.push_back(make_pair(*del, (size_t)0));
+                ++strings[i].second;
+            }
+        });
+
+        IndexDiagnostics diagnostics;
+        for (auto it = deletes.begin(); it != deletesEnd; ++it)
+        {
+            size_t size = it->second.size();
+            size_t dominant = 0, strings = 1;
+            auto originsFinded = origins.find(it->first);
+            if (originsFinded != origins.end())
+            {
+                strings = originsFinded->second.size();
+                for (size_t i = 0; i < strings; ++i) dominant = max(dominant, originsFinded->second[i].second);
+            }
+            diagnostics.AddBucket(size, size > dominant ? size - dominant : 0, strings);
+        }
+        return diagnostics;
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::DeleteStrings(string word, int editDistance, unordered_set<string> & deleteWords)
+    {
+        ++editDistance;
+        int wordLen = (int)word.size();
+        if (wordLen > 1)
+        {
+            for (int i = 0; i < wordLen; ++i)
+            {
+                string tmp = word.substr(0, i) + word.substr(i + 1);
+                if (deleteWords.insert(tmp).second && editDistance < maxDictionaryEditDistance && (wordLen - 1) > 1)
+                    DeleteStrings(tmp, editDistance, deleteWords);
+            }
+        }
+    }
+
+    template <typename MapPolicy>
+    symspell::MemoryUsage BasicSymSpell<MapPolicy>::MemoryUsage(Stage* staging)
+    {
+        symspell::MemoryUsage usage;
+        usage.wordsBytes = MapPolicy::TableBytes(words);
+        for (auto it = words.begin(); it != wordsEnd; ++it)
+            usage.wordsBytes += memory::StringHeapBytes(it->first);
+        usage.termStoreBytes = terms.MemoryUsage();
+        usage.wordsBytes += MapPolicy::TableBytes(surfaceForms);
+        for (auto it = surfaceForms.begin(); it != surfaceFormsEnd; ++it)
+            usage.wordsBytes += memory::StringHeapBytes(it->first) + memory::StringHeapBytes(it->second.first);
+        usage.belowThresholdWordsBytes = MapPolicy::TableBytes(belowThresholdWords);
+        for (auto it = belowThresholdWords.begin(); it != belowThresholdWordsEnd; ++it)
+            usage.belowThresholdWordsBytes += memory::StringHeapBytes(it->first);
+
+        usage.deletesTableBytes = MapPolicy::TableBytes(deletes);
+        for (auto it = deletes.begin(); it != deletesEnd; ++it)
+        {
+            const Bucket& bucket = it->second;
+            usage.bucketVectorsBytes += MapPolicy::BucketBytes(bucket);
+            for (size_t i = 0; i < bucket.size(); ++i)
+                usage.suggestionStringsBytes += MapPolicy::StringBytes(bucket[i]);
+            ++usage.buckets;
+            usage.entries += bucket.size();
+            usage.maxBucketLength = max(usage.maxBucketLength, bucket.size());
+        }
+
+        usage.stagingBytes = MapPolicy::TableBytes(edits);
+        if (staging != nullptr) usage.stagingBytes += staging->MemoryUsage();
+        usage.prefixIndexBytes = prefixIndex.MemoryUsage();
+        usage.deleteFilterBytes = deleteFilter.MemoryUsage();
+        usage.frozenWordsBytes = knownWords.MemoryUsage();
+        return usage;
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::BuildDeleteFilter(double bitsPerKey)
+    {
+        deleteFilter.Build(deletes.size(), bitsPerKey);
+        for (auto it = deletes.begin(); it != deletesEnd; ++it)
+            deleteFilter.Insert(it->first);
+    }
+
+    template <typename MapPolicy>
+    DeleteFilterReport BasicSymSpell<MapPolicy>::DiagnoseDeleteFilter(size_t samples)
+    {
+        DeleteFilterReport report;
+        report.keys = deleteFilter.Keys();
+        report.bytes = deleteFilter.MemoryUsage();
+        report.bitsPerKey = report.keys == 0 ? 0 : report.bytes * 8.0 / report.keys;
+        report.fillRatio = deleteFilter.FillRatio();
+        report.estimatedFalsePositiveRate = deleteFilter.EstimatedFalsePositiveRate();
+
+        // splitmix64 sequence: hashes spread like delete hashes, nearly all of them absent from deletes
+        uint64_t state = 0x9e3779b97f4a7c15ULL;
+        size_t passed = 0;
+        for (size_t i = 0; i < samples; ++i)
+        {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z ^= z >> 31;
+            if (deletes.find((size_t)z) != deletesEnd) continue;
+            ++report.samples;
+            if (deleteFilter.MayContain(z)) ++passed;
+        }
+        report.measuredFalsePositiveRate = report.samples == 0 ? 0 : (double)passed / report.samples;
+        return report;
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::FinishLoading()
+    {
+        BuildDeleteFilter(deleteFilter.BitsPerKey());
+        FreezeWords();
+        SortBuckets();
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::SortBuckets()
+    {
+        string lWord, rWord;
+        for (auto it = deletes.begin(); it != deletesEnd; ++it)
+        {
+            Bucket& bucket = it->second;
+            if (bucket.size() < 2) continue;
+            std::sort(bucket.begin(), bucket.end(), [this, &lWord, &rWord](const typename MapPolicy::String& l, const typename MapPolicy::String& r)
+            {
+                if (l.size() != r.size()) return l.size() < r.size();
+                long lCount = 0, rCount = 0;
+                FindWord(AsStdString(l, lWord), lCount);
+                FindWord(AsStdString(r, rWord), rCount);
+                if (lCount != rCount) return lCount > rCount;
+                return l < r;
+            });
+        }
+        bucketsSorted = true;
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::FreezeWords()
+    {
+        vector<pair<string, long>> entries;
+        entries.reserve(WordCount());
+        ForEachWord([&](const string& key, long count)
+        {
+            entries.push_back(make_pair(key, count));
+        });
+        knownWords.Build(entries, quantizeCounts);
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::QuantizeCounts(bool enable)
+    {
+        if (quantizeCounts == enable) return;
+        // after CompactTerms the quantized codes are the only counts left: the exact ones cannot come back
+        if (!enable && termsCompacted) throw std::logic_error("QuantizeCounts");
+        quantizeCounts = enable;
+        if (!knownWords.Empty()) FreezeWords();
+    }
+
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::FindWord(const string& word, long& count)
+    {
+        if (!knownWords.Empty()) return knownWords.Find(word, &count);
+        auto wordsFinded = words.find(word);
+        if (wordsFinded == wordsEnd) return false;
+        count = wordsFinded->second;
+        return true;
+    }
+
+    template <typename MapPolicy>
+    bool BasicSymSpell<MapPolicy>::IsKnown(const string& word, long* count)
+    {
+        long found = 0;
+        bool known = normalizer.Enabled() ? FindWord(normalizer.Fold(word), found) : FindWord(word, found);
+        if (count != nullptr) *count = known ? found : 0;
+        return known;
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::IsKnownBatch(const vector<string>& words, vector<uint8_t>& known, vector<long>* counts, size_t threads)
+    {
+        known.resize(words.size());
+        if (counts != nullptr) counts->resize(words.size());
+        const vector<string>* queries = &words;
+        vector<string> folded;
+        if (normalizer.Enabled())
+        {
+            folded.resize(words.size());
+            for (size_t i = 0; i < words.size(); ++i) normalizer.Fold(words[i], folded[i]);
+            queries = &folded;
+        }
+        if (!knownWords.Empty())
+        {
+            knownWords.FindBatch(queries->data(), queries->size(), known.data(), counts == nullptr ? nullptr : counts->data(), threads);
+            return;
+        }
+        for (size_t i = 0; i < queries->size(); ++i)
+        {
+            long count = 0;
+            known[i] = FindWord((*queries)[i], count) ? 1 : 0;
+            if (counts != nullptr) (*counts)[i] = known[i] ? count : 0;
+        }
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::BuildPrefixIndex()
+    {
+        prefixIndex.Clear();
+        ForEachWord([this](const string& key, long count)
+        {
+            prefixIndex.Add(key, count);
+        });
+        prefixIndex.Build();
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::Complete(const string& prefix, size_t k, vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    {
+        prefixIndex.Complete(normalizer.Fold(prefix), k, items);
+        ToSurfaceForms(prefix, std::numeric_limits<int>::max(), items);
+    }
+
+    template <typename MapPolicy>
+    void BasicSymSpell<MapPolicy>::LookupPrefix(const string& partialInput, int maxEditDistance, size_t k, vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    {
+        PrefixSession session(prefixIndex, maxEditDistance);
+        session.Update(normalizer.Fold(partialInput));
+        session.Suggestions(k, items);
+        ToSurfaceForms(partialInput, maxEditDistance, items);
+    }
+
+    template class BasicSymSpell<StdMapPolicy>;
+    template class BasicSymSpell<FlatMapPolicy>;
+    template class BasicSymSpell<ArenaMapPolicy>;
 }
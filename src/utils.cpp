@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "normalizer.h"
 
 using namespace std;
 
@@ -23,7 +24,35 @@ template <typename T> void fromUTF8(const string& source, basic_string<T, char_t
 }
 
 
-    int levenshtein_dist(string& word1, string& word2) 
+    namespace {
+        // UTF-8 to code points; a byte that does not start a valid sequence stands for itself
+        void decodeUTF8(const string& source, vector<uint32_t>& result)
+        {
+            result.clear();
+            size_t i = 0, n = source.size();
+            while (i < n)
+            {
+                unsigned char b = (unsigned char)source[i];
+                size_t length = b < 0x80 ? 1 : b >= 0xF0 ? 4 : b >= 0xE0 ? 3 : b >= 0xC0 ? 2 : 0;
+                uint32_t cp = length == 1 ? b : length == 2 ? (b & 0x1F) : length == 3 ? (b & 0x0F) : (b & 0x07);
+                size_t k = 1;
+                while (k < length && i + k < n && ((unsigned char)source[i + k] & 0xC0) == 0x80)
+                {
+                    cp = (cp << 6) | ((unsigned char)source[i + k] & 0x3F);
+                    ++k;
+                }
+                if (length == 0 || k < length)
+                {
+                    cp = b;
+                    k = 1;
+                }
+                result.push_back(cp);
+                i += k;
+            }
+        }
+    }
+
+    int levenshtein_dist(const string& word1, const string& word2) 
     {
         ///
         ///  Please use lower-case strings
@@ -60,21 +89,23 @@ template <typename T> void fromUTF8(const string& source, basic_string<T, char_t
         return(res);
     }
 
-    int dl_dist(string& word1, string& word2) 
+    int dl_dist(const string& word1, const string& word2) 
     {
         /// Damerau-Levenshtein distance
         ///  Please use lower-case strings
         /// word1 : first word
         /// word2 : second word
         ///
-        wstring wword1;
-        wstring wword2;
-        fromUTF8(word1,wword1);
-        fromUTF8(word2,wword2);
+        // decoded and DP buffers are reused per thread; wstring_convert took a locale lock on every call
+        static thread_local vector<uint32_t> wword1;
+        static thread_local vector<uint32_t> wword2;
+        static thread_local vector<int> dist;
+        decodeUTF8(word1,wword1);
+        decodeUTF8(word2,wword2);
         int size1 = (int)wword1.size() + 1;
         int size2 = (int)wword2.size() + 1;
         int suppr_dist, insert_dist, subs_dist, val;
-        vector<int> dist(size1*size2,0.0);
+        dist.assign(size1*size2,0);
 
         for (int i = 0; i < size1; ++i)
             dist[size2*i] = i;
@@ -98,95 +129,22 @@ template <typename T> void fromUTF8(const string& source, basic_string<T, char_t
 //         delete[] dist;
         return(res);
     }
-    int dl_dist_spe(string& word1, string& word2) 
+    int dl_dist_spe(const string& word1, const string& word2) 
     {
-        /// Damerau-Levenshtein distance
-        ///  Please use lower-case strings
+        /// Damerau-Levenshtein distance, accented letters equal to their base letter
         /// word1 : first word
         /// word2 : second word
         ///
-        wstring wword1;
-        wstring wword2;
-        fromUTF8(word1,wword1);
-        fromUTF8(word2,wword2);
-        int size1 = (int)wword1.size() + 1;
-        int size2 = (int)wword2.size() + 1;
-        int suppr_dist, insert_dist, subs_dist, val;
-        vector<int> dist(size1*size2,0.0);
-
-        for (int i = 0; i < size1; ++i)
-            dist[size2*i] = i;
-        for (int j = 0; j < size2; ++j)
-            dist[j] = j;
-        for (int i = 1; i < size1; ++i) {
-            for (int j = 1; j < size2; ++j) {
-                suppr_dist = dist[size2*(i - 1) + j] + 1;
-                insert_dist = dist[size2*i + j - 1] + 1;
-                subs_dist = dist[size2*(i - 1) + j - 1];
-                if (wword1[i - 1] != wword2[j - 1])  // word indexes are implemented differently.
-                    if ((wword1[i - 1] == L'é' || wword1[i - 1] == L'è' || wword1[i - 1] == L'ê' || wword1[i - 1] == L'ë' ) && wword2[j - 1] == L'e' ) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                    if (wword1[i - 1] == L'e'  && (wword2[i - 1] == L'é' || wword2[i - 1] == L'è' || wword2[i - 1] == L'ê' || wword2[i - 1] == L'ë' )) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else  
-                    if ((wword1[i - 1] == L'à' || wword1[i - 1] == L'â' ) && wword2[j - 1] == L'a' ) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                    if (wword1[i - 1] == L'a'  && (wword2[i - 1] == L'à' || wword2[i - 1] == L'â' )) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else  
-                    if ((wword1[i - 1] == L'î' || wword1[i - 1] == L'ï' ) && wword2[j - 1] == L'i' ) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                    if (wword1[i - 1] == L'i'  && (wword2[i - 1] == L'î' || wword2[i - 1] == L'ï' )) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                    if ((wword1[i - 1] == L'ô' || wword1[i - 1] == L'ö' ) && wword2[j - 1] == L'o' ) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                    if (wword1[i - 1] == L'o'  && (wword2[i - 1] == L'ô' || wword2[i - 1] == L'ö' )) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else  
-                    if ((wword1[i - 1] == L'ü' || wword1[i - 1] == L'ù' ) && wword2[j - 1] == L'u' ) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                    if (wword1[i - 1] == L'u'  && (wword2[i - 1] == L'ü' || wword2[i - 1] == L'ù' )) 
-                    {
-                        subs_dist += 0;
-                    }
-                    else
-                        subs_dist += 1;
-                val = mini(suppr_dist, insert_dist, subs_dist);
-                if (((i >= 2) && (j >= 2)) && ((wword1[i - 1] == wword2[j - 2]) && (wword1[i - 2] == wword2[j - 1])))
-                    val = min(dist[size2*(i - 2) + j - 2] + 1, val);
-                dist[size2*i + j] = val;
-            }
-        }
-
-        int res = dist[size1*size2 - 1];
-//         delete[] dist;
-        return(res);
+        static const Normalizer diacritics(Normalizer::Diacritics);
+        static thread_local string folded1;
+        static thread_local string folded2;
+        folded1.clear();
+        folded2.clear();
+        diacritics.Fold(word1, folded1);
+        diacritics.Fold(word2, folded2);
+        return dl_dist(folded1, folded2);
     }
-    float dl_dist_float(string& word1, string& word2) 
+    float dl_dist_float(const string& word1, const string& word2) 
     {
         /// Damerau-Levenshtein distance
         ///  Please use lower-case strings
@@ -3,7 +3,7 @@
 
 namespace symspell {
 
-    void WordSegmentationItem::set(string pSegmentedString, string pCorrectedString, u_int8_t pDistanceSum, double pProbabilityLogSum)
+    void WordSegmentationItem::set(string pSegmentedString, string pCorrectedString, long pDistanceSum, double pProbabilityLogSum)
     {
         this->segmentedString = pSegmentedString;
         this->correctedString = pCorrectedString;
@@ -0,0 +1,59 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    // an arena with small blocks, so that bucket arrays take the oversized path
+    MonotonicArena arena(64 << 10);
+    // up to a quarter block comes from the current block
+    char* first = (char*)arena.Allocate(16 << 10, 8);
+    CHECK((char*)arena.Allocate(16 << 10, 8) == first + (16 << 10));
+    CHECK((char*)arena.Allocate(16 << 10, 8) == first + (32 << 10));
+    size_t blocks = arena.BlockCount();
+    // does not fit the rest of the block, and is over a quarter block: a block of its own
+    void* large = arena.Allocate(32 << 10, 8);
+    CHECK(arena.BlockCount() == blocks + 1);
+    // the current block stays current
+    void* next = arena.Allocate(100, 8);
+    CHECK((char*)next == first + (48 << 10));
+    CHECK(large != nullptr);
+    arena.Release();
+    CHECK(arena.BlockCount() == 0 && arena.BytesUsed() == 0);
+
+    // the arena is required by ArenaMapPolicy and rejected by the others
+    CHECK_THROWS(BasicSymSpell<ArenaMapPolicy>(), std::invalid_argument);
+    CHECK_THROWS(BasicSymSpell<StdMapPolicy>(defaultInitialCapacity, 2, 7, 1, defaultCompactLevel, &arena), std::invalid_argument);
+    CHECK_THROWS(BasicSuggestionStage<ArenaMapPolicy>(1024), std::invalid_argument);
+    CHECK_THROWS(BasicSuggestionStage<FlatMapPolicy>(1024, &arena), std::invalid_argument);
+
+    // lookups on the arena index equal the StdMapPolicy ones, loaded directly and through a stage
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> queries = test::Queries(dictionary);
+    BasicSymSpell<StdMapPolicy> baseline(defaultInitialCapacity, 2, 7);
+    test::Load(baseline, dictionary);
+    {
+        MonotonicArena indexArena(1 << 20);
+        BasicSymSpell<ArenaMapPolicy> direct(defaultInitialCapacity, 2, 7, 1, defaultCompactLevel, &indexArena);
+        test::Load(direct, dictionary);
+        CHECK(indexArena.BytesUsed() > 0);
+        CHECK(direct.WordCount() == baseline.WordCount() && direct.EntryCount() == baseline.EntryCount());
+        for (int v = 0; v < 3; ++v)
+            CHECK(test::LookupAll(direct, queries, (Verbosity)v, 2) == test::LookupAll(baseline, queries, (Verbosity)v, 2));
+
+        MonotonicArena stagedArena(1 << 20), scratch(1 << 20);
+        BasicSymSpell<ArenaMapPolicy> staged(defaultInitialCapacity, 2, 7, 1, defaultCompactLevel, &stagedArena);
+        {
+            BasicSuggestionStage<ArenaMapPolicy> stage(16384, &scratch);
+            for (size_t i = 0; i < dictionary.size(); ++i) staged.CreateDictionaryEntry(dictionary[i].first, dictionary[i].second, &stage);
+            staged.CommitStaged(stage);
+        }
+        scratch.Release();
+        staged.FinishLoading();
+        CHECK(staged.EntryCount() == baseline.EntryCount());
+        for (int v = 0; v < 3; ++v)
+            CHECK(test::LookupAll(staged, queries, (Verbosity)v, 2) == test::LookupAll(baseline, queries, (Verbosity)v, 2));
+    }
+    return test::Result();
+}
@@ -0,0 +1,38 @@
+#include "testutils.h"
+#include "../include/asynclookup.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> queries = test::Queries(dictionary, 500);
+    SymSpell symSpell(defaultInitialCapacity, 2, 7);
+    test::Load(symSpell, dictionary);
+
+    // lookups on four workers answer what the calling thread gets
+    AsyncLookup executor(symSpell, 4, 64);
+    vector<unique_ptr<SuggestItem>> expected;
+    for (int v = 0; v < 3; ++v)
+    {
+        vector<future<AsyncLookupResult>> results;
+        for (size_t i = 0; i < queries.size(); ++i) results.push_back(executor.LookupAsync(queries[i], (Verbosity)v, 2, true));
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            AsyncLookupResult result = results[i].get();
+            string query = queries[i];
+            symSpell.Lookup(query, (Verbosity)v, 2, true, expected);
+            bool same = result.status == AsyncLookupResult::Done && result.suggestions.size() == expected.size();
+            for (size_t j = 0; same && j < expected.size(); ++j)
+                same = result.suggestions[j]->term == expected[j]->term && result.suggestions[j]->distance == expected[j]->distance && result.suggestions[j]->count == expected[j]->count;
+            CHECK(same);
+        }
+    }
+
+    // a maximum edit distance above the dictionary's is refused when queued, not on a worker
+    CHECK_THROWS(executor.LookupAsync(queries[0], Verbosity::Top, 3, false), std::invalid_argument);
+    executor.Shutdown();
+    CHECK(executor.LookupAsync(queries[0], Verbosity::Top).get().status == AsyncLookupResult::Rejected);
+    return test::Result();
+}
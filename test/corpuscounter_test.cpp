@@ -0,0 +1,49 @@
+#include "testutils.h"
+#include <map>
+#include "../include/corpuscounter.h"
+
+using namespace std;
+using namespace symspell;
+
+namespace {
+    map<string, long> CountText(const string& text, size_t threads = 1)
+    {
+        const string path = "corpuscounter_test.txt";
+        {
+            ofstream file(path, ios::binary);
+            file << text;
+        }
+        CorpusCounter counter(1, threads);
+        CHECK(counter.Count(vector<string>{ path }));
+        remove(path.c_str());
+        vector<pair<string, long>> counts = counter.Counts();
+        return map<string, long>(counts.begin(), counts.end());
+    }
+}
+
+int main()
+{
+    // ASCII: digits, underscores and punctuation separate words, letters are lower cased
+    map<string, long> ascii = CountText("The cat_sat, on the MAT.\nmat2mat\n");
+    CHECK(ascii == (map<string, long>{ { "the", 2 }, { "cat", 1 }, { "sat", 1 }, { "on", 1 }, { "mat", 3 } }));
+
+    // non-ASCII punctuation, spaces and symbols separate words: em dash, no-break space, guillemets, curly quotes, ellipsis, ideographic comma, emoji
+    map<string, long> punctuation = CountText("mot\u2014mot a\u00A0b \u00ABmot\u00BB \u201Cmot\u201D mot\u2026 mot\u3001mot \U0001F600mot\n");
+    CHECK(punctuation == (map<string, long>{ { "mot", 8 }, { "a", 1 }, { "b", 1 } }));
+
+    // letters of other scripts, Latin-1 letters and combining marks (a decomposed e\u0301) stay inside words
+    map<string, long> letters = CountText("caf\u00E9 na\u00EFve \u00BAx stra\u00DFe \u043C\u0438\u0440 cafe\u0301 \u00E9t\u00E9\u00D72\n");
+    CHECK(letters == (map<string, long>{ { "caf\u00E9", 1 }, { "na\u00EFve", 1 }, { "\u00BAx", 1 }, { "stra\u00DFe", 1 },
+        { "\u043C\u0438\u0440", 1 }, { "cafe\u0301", 1 }, { "\u00E9t\u00E9", 1 } }));
+
+    // malformed UTF-8 separates words instead of joining them
+    map<string, long> malformed = CountText(string("ab\xFF" "cd \xC3 ef") + "\n");
+    CHECK(malformed == (map<string, long>{ { "ab", 1 }, { "cd", 1 }, { "ef", 1 } }));
+
+    // several threads count the same words
+    string text;
+    for (int i = 0; i < 20000; ++i) text += "alpha\u2014beta gamma alpha\n";
+    map<string, long> threaded = CountText(text, 4);
+    CHECK(threaded == (map<string, long>{ { "alpha", 40000 }, { "beta", 20000 }, { "gamma", 20000 } }));
+    return test::Result();
+}
@@ -0,0 +1,60 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    // small counts decode exactly, larger ones within a step, and the log table matches the decoded counts
+    for (long count = 1; count < 1500; ++count) CHECK(CountQuantizer::Decode(CountQuantizer::Encode(count)) == count);
+    double step = CountQuantizer::Step();
+    for (long count = 1500; count < 4000000000L; count = count * 3 / 2 + 7)
+    {
+        uint16_t code = CountQuantizer::Encode(count);
+        double decoded = (double)CountQuantizer::Decode(code);
+        CHECK(fabs(decoded - count) <= count * step);
+        CHECK(fabs(pow(10.0, CountQuantizer::Log10(code)) - decoded) <= 0.5 + 1e-9 * decoded);
+        // counts more than a step apart keep their order
+        long larger = (long)(count * (1 + 2 * step)) + 1;
+        CHECK(CountQuantizer::Encode(larger) > code);
+    }
+    CHECK(CountQuantizer::Encode(0) == 0 && CountQuantizer::Decode(0) == 0);
+
+    // Top suggestions equal the exact ones, except where the counts of two candidates are within a step
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    // spread the counts so that they are rarely within a step of each other
+    for (size_t i = 0; i < dictionary.size(); ++i) dictionary[i].second = dictionary[i].second * 100003 + (long)i;
+    SymSpell exact(defaultInitialCapacity, 2, 7);
+    SymSpell quantized(defaultInitialCapacity, 2, 7);
+    test::Load(exact, dictionary);
+    quantized.QuantizeCounts();
+    test::Load(quantized, dictionary);
+    vector<string> queries = test::Queries(dictionary);
+    vector<unique_ptr<SuggestItem>> exactItems, quantizedItems;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        string query = queries[i];
+        exact.Lookup(query, Verbosity::Top, 2, exactItems);
+        quantized.Lookup(query, Verbosity::Top, 2, quantizedItems);
+        CHECK(exactItems.size() == quantizedItems.size());
+        if (exactItems.empty() || quantizedItems.empty()) continue;
+        CHECK(exactItems[0]->distance == quantizedItems[0]->distance);
+        if (exactItems[0]->term == quantizedItems[0]->term) continue;
+        long exactCount = 0, otherCount = 0;
+        exact.IsKnown(exactItems[0]->term, &exactCount);
+        exact.IsKnown(quantizedItems[0]->term, &otherCount);
+        CHECK(fabs((double)exactCount - otherCount) <= exactCount * step);
+    }
+
+    // segmentation reads log counts from the quantizer table and splits concatenated words as the exact counts do
+    for (size_t i = 0; i + 2 < 300; i += 3)
+    {
+        string text = dictionary[i].first + dictionary[i + 1].first + dictionary[i + 2].first;
+        string copy = text;
+        shared_ptr<WordSegmentationItem> exactSegmentation = exact.WordSegmentation(text, 0);
+        shared_ptr<WordSegmentationItem> quantizedSegmentation = quantized.WordSegmentation(copy, 0);
+        CHECK(exactSegmentation->segmentedString == quantizedSegmentation->segmentedString);
+        CHECK(fabs(exactSegmentation->probabilityLogSum - quantizedSegmentation->probabilityLogSum) < 3 * 4.4e-4);
+    }
+    return test::Result();
+}
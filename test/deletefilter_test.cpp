@@ -0,0 +1,31 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> queries = test::Queries(dictionary, 500);
+    SymSpell filtered(defaultInitialCapacity, 2, 7), unfiltered(defaultInitialCapacity, 2, 7);
+    test::Load(filtered, dictionary);
+    test::Load(unfiltered, dictionary);
+    unfiltered.DropDeleteFilter();
+    CHECK(filtered.DiagnoseDeleteFilter(1000).bytes > 0 && unfiltered.DiagnoseDeleteFilter(1000).bytes == 0);
+    for (int v = 0; v < 3; ++v)
+        for (int maxEditDistance = 0; maxEditDistance <= 2; ++maxEditDistance)
+            CHECK(test::LookupAll(filtered, queries, (Verbosity)v, maxEditDistance) == test::LookupAll(unfiltered, queries, (Verbosity)v, maxEditDistance));
+
+    // words added after FinishLoading go into the filter, which grows past twice its size
+    vector<pair<string, long>> more = test::Dictionary(12000, 13);
+    for (size_t i = 0; i < more.size(); ++i)
+    {
+        filtered.CreateDictionaryEntry(more[i].first, more[i].second);
+        unfiltered.CreateDictionaryEntry(more[i].first, more[i].second);
+    }
+    CHECK(filtered.DiagnoseDeleteFilter(1000).keys > filtered.DiagnoseIndex().buckets / 2);
+    vector<string> moreQueries = test::Queries(more, 500, 17);
+    for (int v = 0; v < 3; ++v)
+        CHECK(test::LookupAll(filtered, moreQueries, (Verbosity)v, 2) == test::LookupAll(unfiltered, moreQueries, (Verbosity)v, 2));
+    return test::Result();
+}
@@ -0,0 +1,51 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> words = test::Queries(dictionary, 2000);
+    for (size_t i = 0; i < dictionary.size(); i += 3) words.push_back(dictionary[i].first);
+
+    // words added without FinishLoading are only in the words map
+    SymSpell frozen(defaultInitialCapacity, 2, 7), unfrozen(defaultInitialCapacity, 2, 7);
+    test::Load(frozen, dictionary);
+    for (size_t i = 0; i < dictionary.size(); ++i) unfrozen.CreateDictionaryEntry(dictionary[i].first, dictionary[i].second);
+
+    size_t known = 0;
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+        long frozenCount = -1, unfrozenCount = -1;
+        bool isKnown = unfrozen.IsKnown(words[i], &unfrozenCount);
+        CHECK(frozen.IsKnown(words[i], &frozenCount) == isKnown && frozenCount == unfrozenCount);
+        if (isKnown) ++known;
+    }
+    // both known and unknown words were asked
+    CHECK(known > 0 && known < words.size());
+
+    vector<uint8_t> expectedKnown, batchKnown;
+    vector<long> expectedCounts, batchCounts;
+    unfrozen.IsKnownBatch(words, expectedKnown, &expectedCounts);
+    for (size_t threads = 1; threads <= 4; threads += 3)
+    {
+        frozen.IsKnownBatch(words, batchKnown, &batchCounts, threads);
+        CHECK(batchKnown == expectedKnown && batchCounts == expectedCounts);
+    }
+
+    // lookups take their counts from the frozen table
+    vector<string> queries = test::Queries(dictionary, 500);
+    frozen.SortBuckets();
+    for (int v = 0; v < 3; ++v)
+        CHECK(test::LookupAll(frozen, queries, (Verbosity)v, 2) == test::LookupAll(unfrozen, queries, (Verbosity)v, 2));
+
+    // adding a word drops the table until FreezeWords
+    frozen.CreateDictionaryEntry("zzzz", 5);
+    unfrozen.CreateDictionaryEntry("zzzz", 5);
+    long count = 0;
+    CHECK(frozen.IsKnown("zzzz", &count) && count == 5);
+    frozen.FreezeWords();
+    CHECK(frozen.IsKnown("zzzz", &count) && count == 5);
+    return test::Result();
+}
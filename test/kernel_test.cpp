@@ -0,0 +1,41 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+namespace {
+    // every fixed kernel set against the run time kernel of the same parameters, on lookups and on the built index
+    template <int MaxEd, int PrefixLen, typename DistancePolicy>
+    void CheckKernel(const vector<pair<string, long>>& dictionary, const vector<string>& queries)
+    {
+        SymSpellT<MaxEd, PrefixLen, DistancePolicy> fixed;
+        SymSpell picked(defaultInitialCapacity, MaxEd, PrefixLen), runtime(defaultInitialCapacity, MaxEd, PrefixLen);
+        picked.setDistanceAlgorithm(DistancePolicy::algorithm);
+        runtime.setDistanceAlgorithm(DistancePolicy::algorithm);
+        runtime.EnableFixedKernels(false);
+        CHECK(fixed.UsesFixedKernel() && picked.UsesFixedKernel() && !runtime.UsesFixedKernel());
+        test::Load(fixed, dictionary);
+        test::Load(picked, dictionary);
+        test::Load(runtime, dictionary);
+        CHECK(fixed.DiagnoseIndex().buckets == runtime.DiagnoseIndex().buckets && fixed.DiagnoseIndex().entries == runtime.DiagnoseIndex().entries);
+        for (int v = 0; v < 3; ++v)
+            for (int maxEditDistance = 0; maxEditDistance <= MaxEd; ++maxEditDistance)
+            {
+                string expected = test::LookupAll(runtime, queries, (Verbosity)v, maxEditDistance);
+                CHECK(test::LookupAll(fixed, queries, (Verbosity)v, maxEditDistance) == expected);
+                CHECK(test::LookupAll(picked, queries, (Verbosity)v, maxEditDistance) == expected);
+            }
+    }
+}
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> queries = test::Queries(dictionary, 500);
+    CheckKernel<1, 7, OsaDistance>(dictionary, queries);
+    CheckKernel<2, 7, OsaDistance>(dictionary, queries);
+    CheckKernel<3, 7, OsaDistance>(dictionary, queries);
+    CheckKernel<1, 5, LevenshteinDistance>(dictionary, queries);
+    CheckKernel<2, 7, LevenshteinDistance>(dictionary, queries);
+    return test::Result();
+}
@@ -0,0 +1,43 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    SymSpell symSpell(defaultInitialCapacity, 2, 7);
+    test::Load(symSpell, dictionary);
+
+    LookupOptions options;
+    options.maxEditDistanceByLength = EditDistanceByLength(vector<int>{ 0, 0, 1, 1, 2 });
+    vector<unique_ptr<SuggestItem>> items;
+
+    // a distance above the dictionary's is rejected whatever the input length, even where the table would lower it
+    string shortInput = "ka";
+    string longInput = "kalemotarisu";
+    CHECK_THROWS(symSpell.Lookup(shortInput, Verbosity::Top, 3, options, items), std::invalid_argument);
+    CHECK_THROWS(symSpell.Lookup(longInput, Verbosity::Top, 3, options, items), std::invalid_argument);
+    CHECK_THROWS(symSpell.Lookup(shortInput, Verbosity::Top, 3, LookupOptions(), items), std::invalid_argument);
+
+    // the table lowers the distance of short inputs: exact matches only up to 1 code point
+    CHECK(options.maxEditDistanceByLength.For("k", 2) == 0);
+    CHECK(options.maxEditDistanceByLength.For("kal", 2) == 1);
+    CHECK(options.maxEditDistanceByLength.For("kalemo", 2) == 2);
+    CHECK(options.maxEditDistanceByLength.For("kalemo", 1) == 1);
+
+    // without budgets or a table the lookup equals the plain one
+    vector<string> queries = test::Queries(dictionary, 200);
+    string plain = test::LookupAll(symSpell, queries, Verbosity::Closest, 2);
+    string bounded;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        string query = queries[i];
+        CHECK(symSpell.Lookup(query, Verbosity::Closest, 2, LookupOptions(), items) == LookupStatus::Complete);
+        for (size_t j = 0; j < items.size(); ++j)
+            bounded += items[j]->term + ":" + to_string(items[j]->distance) + ":" + to_string(items[j]->count) + " ";
+        bounded += "\n";
+    }
+    CHECK(plain == bounded);
+    return test::Result();
+}
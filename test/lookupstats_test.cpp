@@ -0,0 +1,33 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    SymSpell symSpell(defaultInitialCapacity, 2, 7);
+    test::Load(symSpell, dictionary);
+    vector<string> queries = test::Queries(dictionary, 100);
+
+    vector<unique_ptr<SuggestItem>> items;
+    LookupStats stats;
+    stats.lookups = 42;
+    string query = queries[0];
+    symSpell.Lookup(query, Verbosity::All, 2, false, items, &stats);
+    if (LookupStatsRegistry::Enabled())
+    {
+        CHECK(stats.lookups == 1);
+        CHECK(stats.candidatesGenerated > 0);
+        CHECK(stats.bucketsProbed + stats.filterRejected == stats.candidatesGenerated);
+    }
+    // without SYMSPELL_STATS nothing is counted or copied
+    else CHECK(stats.lookups == 42);
+
+    string text = dictionary[0].first + dictionary[1].first;
+    LookupStats segmentation;
+    symSpell.WordSegmentation(text, 1, symSpell.MaxLength(), &segmentation);
+    if (LookupStatsRegistry::Enabled()) CHECK(segmentation.segmentations == 1 && segmentation.segmentationParts > 0);
+    else CHECK(segmentation.segmentations == 0 && segmentation.lookups == 0);
+    return test::Result();
+}
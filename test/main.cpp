@@ -1,59 +1,281 @@
 #include <iostream>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <map>
+#include <deque>
+#include <cstdlib>
 #include "../include/symspell.h"
 
 using namespace std;
 
-void Split(const std::string &line, std::vector<std::string> &pieces, const std::string del) 
-{
-  size_t begin = 0;
-  size_t pos = 0;
-  std::string token;
-
-  while ((pos = line.find(del, begin)) != std::string::npos) 
-  {
-      if (pos > begin) 
-      {
-          token = line.substr(begin, pos - begin);
-          if (token.size() > 0) pieces.push_back(token);
-      }
-      begin = pos + del.size();
-  }
-  if (pos > begin) 
-  {
-      token = line.substr(begin, pos - begin);
-  }
-  if (token.size() > 0) pieces.push_back(token);
-}
+// Streaming autocorrection: stdin is read in large blocks cut at line boundaries, worker threads
+// correct whole blocks, and a writer emits the corrected blocks in input order.
 
+namespace {
 
-int main(int argc, char* argv[])
-{
-	symspell::SymSpell symSpell;
-        symSpell.LoadDictionary(argv[1],1,0);
+    const size_t blockSize = 1 << 20;
+
+    struct Options
+    {
+        string dictionary;
+        int threads = max(1, (int)std::thread::hardware_concurrency());
+        symspell::Verbosity verbosity = symspell::Verbosity::All;
+        int maxEditDistance = defaultMaxEditDistance;
         int nbest = 1;
-        vector< std::unique_ptr<symspell::SuggestItem>> items;
-        std::string line;
-        symSpell.setDistanceAlgorithm(symspell::EditDistance::DistanceAlgorithm::DamerauOSAspe);
-        
-        
-        while (std::getline(std::cin, line))
-        {
-            vector<string> vec_line;
-//             std::cout << line << std::endl;
-            Split(line,vec_line," ");
-            int inc=0;
-            while (inc < (int)vec_line.size())
+    };
+
+    struct Block
+    {
+        size_t sequence = 0;
+        string input;
+        string output;
+        size_t lines = 0;
+        size_t tokens = 0;
+    };
+
+    /// <summary>Blocks between the reader, the workers and the writer, with a cap on blocks in flight.</summary>
+    class Pipeline
+    {
+    public:
+        explicit Pipeline(size_t maxInFlight) : maxInFlight(maxInFlight) { }
+
+        // reader side: blocks while maxInFlight blocks are being processed or written
+        void Submit(unique_ptr<Block> block)
+        {
+            unique_lock<mutex> lock(mtx);
+            changed.wait(lock, [this] { return inFlight < maxInFlight; });
+            ++inFlight;
+            pending.push_back(std::move(block));
+            changed.notify_all();
+        }
+
+        void Close()
+        {
+            lock_guard<mutex> lock(mtx);
+            closed = true;
+            changed.notify_all();
+        }
+
+        // worker side: nullptr once the input is exhausted
+        unique_ptr<Block> Take()
+        {
+            unique_lock<mutex> lock(mtx);
+            changed.wait(lock, [this] { return !pending.empty() || closed; });
+            if (pending.empty()) return nullptr;
+            unique_ptr<Block> block = std::move(pending.front());
+            pending.pop_front();
+            return block;
+        }
+
+        void Complete(unique_ptr<Block> block)
+        {
+            lock_guard<mutex> lock(mtx);
+            size_t sequence = block->sequence;
+            done[sequence] = std::move(block);
+            changed.notify_all();
+        }
+
+        // writer side: the next block in input order, nullptr after the last one
+        unique_ptr<Block> Next(size_t sequence)
+        {
+            unique_lock<mutex> lock(mtx);
+            changed.wait(lock, [this, sequence] { return done.count(sequence) > 0 || (closed && inFlight == 0); });
+            auto finded = done.find(sequence);
+            if (finded == done.end()) return nullptr;
+            unique_ptr<Block> block = std::move(finded->second);
+            done.erase(finded);
+            return block;
+        }
+
+        void Release()
+        {
+            lock_guard<mutex> lock(mtx);
+            --inFlight;
+            changed.notify_all();
+        }
+
+    private:
+        mutex mtx;
+        condition_variable changed;
+        deque<unique_ptr<Block>> pending;
+        map<size_t, unique_ptr<Block>> done;
+        size_t maxInFlight;
+        size_t inFlight = 0;
+        bool closed = false;
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> [--threads N] [--verbosity top|closest|all] [--max-edit-distance D] [--nbest N] < input > output" << endl;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--threads" && hasValue) options.threads = max(1, atoi(argv[++i]));
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--nbest" && hasValue) options.nbest = max(1, atoi(argv[++i]));
+            else if (arg == "--verbosity" && hasValue)
             {
-                items.clear();
-                symSpell.Lookup(vec_line[inc], symspell::Verbosity::All, items);
-                for(int i=0 ; i < nbest && i < (int)items.size(); i++)
-                {    
-//                     cout << vec_line[inc] << "\t" << items[i]->term << "\t" << items[i]->count << "\t" << items[i]->distance << endl;
-                    if (inc != 0) cout << " ";
-                    cout << items[i]->term ; 
+                string value = argv[++i];
+                if (value == "top") options.verbosity = symspell::Verbosity::Top;
+                else if (value == "closest") options.verbosity = symspell::Verbosity::Closest;
+                else if (value == "all") options.verbosity = symspell::Verbosity::All;
+                else return false;
+            }
+            else if (arg.compare(0, 2, "--") != 0 && options.dictionary.empty()) options.dictionary = arg;
+            else return false;
+        }
+        return !options.dictionary.empty();
+    }
+
+    // Corrects every space separated token of the block's lines; tokens without suggestion are dropped,
+    // alternatives of one token (nbest > 1) are separated by '|'.
+    void CorrectBlock(symspell::SymSpell& symSpell, const Options& options, Block& block)
+    {
+        vector<std::unique_ptr<symspell::SuggestItem>> items;
+        string token;
+        const char* p = block.input.data();
+        const char* end = p + block.input.size();
+        block.output.reserve(block.input.size() + block.input.size() / 8);
+        while (p < end)
+        {
+            const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+            if (lineEnd == nullptr) lineEnd = end;
+            bool first = true;
+            while (p < lineEnd)
+            {
+                const char* tokenEnd = (const char*)memchr(p, ' ', lineEnd - p);
+                if (tokenEnd == nullptr) tokenEnd = lineEnd;
+                if (tokenEnd > p)
+                {
+                    token.assign(p, tokenEnd - p);
+                    ++block.tokens;
+                    // most tokens are spelled right: Top and Closest would only return the token itself
+                    if (options.verbosity != symspell::Verbosity::All && symSpell.IsKnown(token))
+                    {
+                        if (!first) block.output += ' ';
+                        block.output += token;
+                        first = false;
+                        p = tokenEnd + 1;
+                        continue;
+                    }
+                    symSpell.Lookup(token, options.verbosity, options.maxEditDistance, items);
+                    for (int i = 0; i < options.nbest && i < (int)items.size(); ++i)
+                    {
+                        if (i > 0) block.output += '|';
+                        else if (!first) block.output += ' ';
+                        block.output += items[i]->term;
+                        first = false;
+                    }
                 }
-                inc++;
+                p = tokenEnd + 1;
             }
-            cout << endl; 
+            block.output += '\n';
+            ++block.lines;
+            p = lineEnd + 1;
         }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    symspell::SymSpell symSpell;
+    if (!symSpell.LoadDictionary(options.dictionary, 1, 0))
+    {
+        cerr << "cannot read " << options.dictionary << endl;
+        return 1;
+    }
+    symSpell.setDistanceAlgorithm(symspell::EditDistance::DistanceAlgorithm::DamerauOSAspe);
+    if (options.maxEditDistance < 0 || options.maxEditDistance > (int)symSpell.MaxDictionaryEditDistance())
+    {
+        cerr << "--max-edit-distance must be between 0 and " << symSpell.MaxDictionaryEditDistance() << endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Pipeline pipeline(2 * options.threads + 2);
+
+    vector<std::thread> workers;
+    for (int t = 0; t < options.threads; ++t)
+    {
+        workers.push_back(std::thread([&]
+        {
+            while (unique_ptr<Block> block = pipeline.Take())
+            {
+                CorrectBlock(symSpell, options, *block);
+                pipeline.Complete(std::move(block));
+            }
+        }));
+    }
+
+    size_t lines = 0, tokens = 0, bytesIn = 0, bytesOut = 0;
+    std::thread writer([&]
+    {
+        for (size_t sequence = 0; ; ++sequence)
+        {
+            unique_ptr<Block> block = pipeline.Next(sequence);
+            if (block == nullptr) break;
+            fwrite(block->output.data(), 1, block->output.size(), stdout);
+            lines += block->lines;
+            tokens += block->tokens;
+            bytesIn += block->input.size();
+            bytesOut += block->output.size();
+            block.reset();
+            pipeline.Release();
+        }
+        fflush(stdout);
+    });
+
+    // reader: read straight into the block buffer, hand over everything up to the last newline
+    // and carry the partial line into the next block
+    string carry;
+    size_t sequence = 0;
+    bool eof = false;
+    while (!eof)
+    {
+        unique_ptr<Block> block(new Block());
+        block->input.swap(carry);
+        size_t used = block->input.size();
+        block->input.resize(used + blockSize);
+        size_t read = fread(&block->input[used], 1, blockSize, stdin);
+        block->input.resize(used + read);
+        eof = read < blockSize;
+
+        size_t cut = block->input.rfind('\n');
+        if (!eof)
+        {
+            if (cut == string::npos)
+            {
+                carry.swap(block->input);
+                continue;
+            }
+            carry.assign(block->input, cut + 1, string::npos);
+            block->input.resize(cut + 1);
+        }
+        if (block->input.empty()) continue;
+        block->sequence = sequence++;
+        pipeline.Submit(std::move(block));
+    }
+    pipeline.Close();
+
+    for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+    writer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    cerr << "lines " << lines << ", tokens " << tokens << ", " << bytesIn << " bytes in, " << bytesOut << " bytes out, "
+         << seconds << " s, " << (seconds > 0 ? tokens / seconds : 0) << " tokens/s, "
+         << (seconds > 0 ? bytesIn / seconds / (1 << 20) : 0) << " MB/s, " << options.threads << " threads" << endl;
+    return 0;
 }
@@ -0,0 +1,30 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> queries = test::Queries(dictionary, 500);
+    BasicSymSpell<StdMapPolicy> standard(defaultInitialCapacity, 2, 7);
+    BasicSymSpell<FlatMapPolicy> flat(defaultInitialCapacity, 2, 7);
+    test::Load(standard, dictionary);
+    test::Load(flat, dictionary);
+    CHECK(flat.DiagnoseIndex().buckets == standard.DiagnoseIndex().buckets && flat.DiagnoseIndex().entries == standard.DiagnoseIndex().entries);
+    for (int v = 0; v < 3; ++v)
+        for (int maxEditDistance = 0; maxEditDistance <= 2; ++maxEditDistance)
+            CHECK(test::LookupAll(flat, queries, (Verbosity)v, maxEditDistance) == test::LookupAll(standard, queries, (Verbosity)v, maxEditDistance));
+
+    // the flat map grows through several rehashes while words are added after loading
+    vector<pair<string, long>> more = test::Dictionary(12000, 13);
+    for (size_t i = 0; i < more.size(); ++i)
+    {
+        standard.CreateDictionaryEntry(more[i].first, more[i].second);
+        flat.CreateDictionaryEntry(more[i].first, more[i].second);
+    }
+    vector<string> moreQueries = test::Queries(more, 500, 17);
+    for (int v = 0; v < 3; ++v)
+        CHECK(test::LookupAll(flat, moreQueries, (Verbosity)v, 2) == test::LookupAll(standard, moreQueries, (Verbosity)v, 2));
+    return test::Result();
+}
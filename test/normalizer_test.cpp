@@ -0,0 +1,62 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+namespace {
+    // capitalizes some words and accents some of their vowels
+    string Decorate(const string& word, size_t i)
+    {
+        string decorated;
+        for (size_t j = 0; j < word.size(); ++j)
+        {
+            if (j == 0 && i % 3 == 0) decorated += (char)toupper(word[j]);
+            else if (word[j] == 'e' && i % 2 == 0) decorated += "\u00e9";
+            else if (word[j] == 'u' && i % 5 == 0) decorated += "\u00dc";
+            else decorated += word[j];
+        }
+        return decorated;
+    }
+}
+
+int main()
+{
+    Normalizer normalizer(Normalizer::CaseAndDiacritics);
+    vector<pair<string, long>> dictionary = test::Dictionary(), folded;
+    for (size_t i = 0; i < dictionary.size(); ++i)
+    {
+        dictionary[i].first = Decorate(dictionary[i].first, i);
+        folded.push_back(make_pair(normalizer.Fold(dictionary[i].first), dictionary[i].second));
+    }
+    vector<string> queries = test::Queries(folded, 500);
+
+    // folding once per word and query answers what a dictionary of folded words answers for folded queries
+    SymSpell folding(defaultInitialCapacity, 2, 7), plain(defaultInitialCapacity, 2, 7);
+    folding.setNormalizer(normalizer);
+    test::Load(folding, dictionary);
+    test::Load(plain, folded);
+    vector<unique_ptr<SuggestItem>> expected, items;
+    for (int v = 0; v < 3; ++v)
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            string query = Decorate(queries[i], i), foldedQuery = normalizer.Fold(query);
+            folding.Lookup(query, (Verbosity)v, 2, items);
+            plain.Lookup(foldedQuery, (Verbosity)v, 2, expected);
+            bool same = items.size() == expected.size();
+            for (size_t j = 0; same && j < items.size(); ++j)
+                same = normalizer.Fold(items[j]->term) == expected[j]->term && items[j]->distance == expected[j]->distance && items[j]->count == expected[j]->count;
+            CHECK(same);
+        }
+
+    // suggestions come back in the most frequent original spelling
+    SymSpell spellings(defaultInitialCapacity, 2, 7);
+    spellings.setNormalizer(normalizer);
+    spellings.CreateDictionaryEntry("r\u00e9sum\u00e9", 10);
+    spellings.CreateDictionaryEntry("Resume", 30);
+    spellings.CreateDictionaryEntry("resume", 5);
+    spellings.FinishLoading();
+    string query = "R\u00c9SUMEE";
+    spellings.Lookup(query, Verbosity::Top, 2, items);
+    CHECK(items.size() == 1 && items[0]->term == "Resume" && items[0]->distance == 1 && items[0]->count == 45);
+    return test::Result();
+}
@@ -0,0 +1,76 @@
+#include "testutils.h"
+#include "../include/streamingsegmenter.h"
+
+using namespace std;
+using namespace symspell;
+
+namespace {
+    const vector<pair<string, long>> phraseWords = {
+        { "the", 100000 }, { "quick", 5000 }, { "brown", 4000 }, { "fox", 3000 }, { "jumps", 2000 },
+        { "over", 20000 }, { "lazy", 1000 }, { "dog", 6000 }, { "he", 50000 }, { "qui", 10 } };
+
+    void CheckKnownInputs()
+    {
+        SymSpell symSpell(defaultInitialCapacity, 2, 7);
+        test::Load(symSpell, phraseWords);
+        string input = "thequickbrownfox";
+        shared_ptr<WordSegmentationItem> result = symSpell.WordSegmentation(input, 2);
+        CHECK(result->segmentedString == "the quick brown fox" && result->correctedString == "the quick brown fox");
+        CHECK(result->distanceSum == 3);
+
+        input = "thequikbrwnfoxjumpsoverthelazydog";
+        result = symSpell.WordSegmentation(input, 2);
+        CHECK(result->segmentedString == "the quik brwn fox jumps over the lazy dog");
+        CHECK(result->correctedString == "the quick brown fox jumps over the lazy dog");
+        CHECK(result->distanceSum == 10);
+
+        // 359 separators and 80 corrections: the sum no longer wraps at 255
+        string phrase = "the quick brown fox jumps over the lazy dog", expected;
+        input.clear();
+        for (int i = 0; i < 40; ++i)
+        {
+            input += "thequikbrwnfoxjumpsoverthelazydog";
+            expected += (i == 0 ? "" : " ") + phrase;
+        }
+        result = symSpell.WordSegmentation(input, 2);
+        CHECK(result->correctedString == expected);
+        CHECK(result->distanceSum == 439);
+    }
+
+    void CheckStreamingEqualsWhole()
+    {
+        vector<pair<string, long>> dictionary = test::Dictionary();
+        vector<string> queries = test::Queries(dictionary, 300);
+        string input;
+        for (size_t i = 0; i < queries.size(); ++i) input += queries[i];
+        SymSpell symSpell(defaultInitialCapacity, 2, 7);
+        test::Load(symSpell, dictionary);
+        shared_ptr<WordSegmentationItem> whole = symSpell.WordSegmentation(input, 1);
+
+        mt19937 random(3);
+        StreamingSegmenter segmenter(symSpell, 1, symSpell.MaxLength());
+        string segmented, corrected, part, correctedPart;
+        for (size_t i = 0; i < input.size();)
+        {
+            size_t length = 1 + random() % 64;
+            segmenter.Feed(input.substr(i, length));
+            i += length;
+            segmenter.Take(part, correctedPart);
+            segmented += part;
+            corrected += correctedPart;
+        }
+        segmenter.Finish();
+        segmenter.Take(part, correctedPart);
+        segmented += part;
+        corrected += correctedPart;
+        CHECK(segmented == whole->segmentedString && corrected == whole->correctedString);
+        CHECK(segmenter.DistanceSum() == whole->distanceSum);
+    }
+}
+
+int main()
+{
+    CheckKnownInputs();
+    CheckStreamingEqualsWhole();
+    return test::Result();
+}
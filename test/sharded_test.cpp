@@ -0,0 +1,31 @@
+#include "testutils.h"
+#include "../include/shardedsymspell.h"
+
+using namespace std;
+using namespace symspell;
+
+int main()
+{
+    vector<pair<string, long>> dictionary = test::Dictionary();
+    vector<string> queries = test::Queries(dictionary, 500);
+    SymSpell single(defaultInitialCapacity, 2, 7);
+    test::Load(single, dictionary);
+    ShardedSymSpell sharded(3, 2, 7);
+    for (size_t i = 0; i < dictionary.size(); ++i) sharded.CreateDictionaryEntry(dictionary[i].first, dictionary[i].second);
+    for (size_t i = 0; i < sharded.ShardCount(); ++i) static_cast<LocalShard&>(sharded.GetShard(i)).Engine().FinishLoading();
+
+    vector<unique_ptr<SuggestItem>> expected, items;
+    for (int v = 0; v < 3; ++v)
+        for (int maxEditDistance = 0; maxEditDistance <= 2; ++maxEditDistance)
+            for (size_t i = 0; i < queries.size(); ++i)
+            {
+                string query = queries[i];
+                single.Lookup(query, (Verbosity)v, maxEditDistance, true, expected);
+                sharded.Lookup(query, (Verbosity)v, maxEditDistance, true, items);
+                bool same = items.size() == expected.size();
+                for (size_t j = 0; same && j < items.size(); ++j)
+                    same = items[j]->term == expected[j]->term && items[j]->distance == expected[j]->distance && items[j]->count == expected[j]->count;
+                CHECK(same);
+            }
+    return test::Result();
+}
@@ -0,0 +1,48 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+namespace {
+    // words added without FinishLoading: the buckets keep insertion order
+    void LoadUnsorted(SymSpell& engine, const vector<pair<string, long>>& dictionary)
+    {
+        for (size_t i = 0; i < dictionary.size(); ++i) engine.CreateDictionaryEntry(dictionary[i].first, dictionary[i].second);
+    }
+
+    void CheckTies()
+    {
+        // equal distance and count to "xat", added in reverse order
+        vector<pair<string, long>> dictionary = { { "rat", 10 }, { "hat", 10 }, { "cat", 10 }, { "bat", 10 }, { "at", 3 } };
+        SymSpell sorted(defaultInitialCapacity, 2, 7), unsorted(defaultInitialCapacity, 2, 7);
+        test::Load(sorted, dictionary);
+        LoadUnsorted(unsorted, dictionary);
+        vector<string> queries = { "xat" };
+        CHECK(test::LookupAll(sorted, queries, Verbosity::Top, 2) == "bat:1:10 \n");
+        CHECK(test::LookupAll(unsorted, queries, Verbosity::Top, 2) == "bat:1:10 \n");
+        CHECK(test::LookupAll(sorted, queries, Verbosity::Closest, 2) == "bat:1:10 cat:1:10 hat:1:10 rat:1:10 at:1:3 \n");
+        CHECK(test::LookupAll(unsorted, queries, Verbosity::Closest, 2) == test::LookupAll(sorted, queries, Verbosity::Closest, 2));
+    }
+
+    void CheckSortedEqualsUnsorted(long distinctCounts)
+    {
+        vector<pair<string, long>> dictionary = test::Dictionary();
+        // few distinct counts: many suggestions tie on distance and count
+        for (size_t i = 0; i < dictionary.size(); ++i) dictionary[i].second = 1 + dictionary[i].second % distinctCounts;
+        vector<string> queries = test::Queries(dictionary);
+        SymSpell sorted(defaultInitialCapacity, 2, 7), unsorted(defaultInitialCapacity, 2, 7);
+        test::Load(sorted, dictionary);
+        LoadUnsorted(unsorted, dictionary);
+        for (int v = 0; v < 3; ++v)
+            for (int maxEditDistance = 1; maxEditDistance <= 2; ++maxEditDistance)
+                CHECK(test::LookupAll(sorted, queries, (Verbosity)v, maxEditDistance) == test::LookupAll(unsorted, queries, (Verbosity)v, maxEditDistance));
+    }
+}
+
+int main()
+{
+    CheckTies();
+    CheckSortedEqualsUnsorted(3);
+    CheckSortedEqualsUnsorted(5000);
+    return test::Result();
+}
@@ -0,0 +1,85 @@
+#include "testutils.h"
+
+using namespace std;
+using namespace symspell;
+
+namespace {
+    void CheckUnknown()
+    {
+        SymSpell symSpell(defaultInitialCapacity, 2, 7);
+        test::Load(symSpell, test::Dictionary());
+        vector<unique_ptr<SuggestItem>> items;
+        // no word is within 2 edits of it, and it is short enough to reach the candidate loop
+        string unknown = "zzzzz";
+        for (int v = 0; v < 3; ++v)
+        {
+            symSpell.Lookup(unknown, (Verbosity)v, 2, true, items);
+            CHECK(items.size() == 1 && items[0]->term == unknown && items[0]->distance == 3 && items[0]->count == 0);
+            symSpell.Lookup(unknown, (Verbosity)v, 2, false, items);
+            CHECK(items.empty());
+        }
+        // too long for any word: the early exit answers the same
+        string tooLong(40, 'z');
+        symSpell.Lookup(tooLong, Verbosity::Top, 2, true, items);
+        CHECK(items.size() == 1 && items[0]->term == tooLong && items[0]->distance == 3);
+    }
+
+    void CheckQuantizeAfterCompact()
+    {
+        vector<pair<string, long>> dictionary = test::Dictionary();
+        for (size_t i = 0; i < dictionary.size(); ++i) dictionary[i].second = dictionary[i].second * 7919 + 1;
+        long count = 0;
+
+        // compacted with exact counts: quantizing afterwards is allowed and one way
+        SymSpell exact(defaultInitialCapacity, 2, 7);
+        test::Load(exact, dictionary);
+        exact.CompactTerms();
+        CHECK(exact.IsKnown(dictionary[0].first, &count) && count == dictionary[0].second);
+        exact.QuantizeCounts();
+        CHECK(exact.IsKnown(dictionary[0].first, &count) && count == CountQuantizer::Decode(CountQuantizer::Encode(dictionary[0].second)));
+        CHECK_THROWS(exact.QuantizeCounts(false), std::logic_error);
+
+        // quantized, then compacted: the exact counts cannot come back
+        SymSpell quantized(defaultInitialCapacity, 2, 7);
+        quantized.QuantizeCounts();
+        test::Load(quantized, dictionary);
+        quantized.CompactTerms();
+        CHECK_THROWS(quantized.QuantizeCounts(false), std::logic_error);
+        quantized.QuantizeCounts(true);
+        CHECK(quantized.IsKnown(dictionary[0].first, &count) && count == CountQuantizer::Decode(CountQuantizer::Encode(dictionary[0].second)));
+
+        // before compaction the words map still has the exact counts
+        SymSpell toggled(defaultInitialCapacity, 2, 7);
+        toggled.QuantizeCounts();
+        test::Load(toggled, dictionary);
+        toggled.QuantizeCounts(false);
+        CHECK(toggled.IsKnown(dictionary[0].first, &count) && count == dictionary[0].second);
+    }
+
+    void CheckCompactedLookups()
+    {
+        vector<pair<string, long>> dictionary = test::Dictionary();
+        vector<string> queries = test::Queries(dictionary, 500);
+        SymSpell words(defaultInitialCapacity, 2, 7), compacted(defaultInitialCapacity, 2, 7);
+        test::Load(words, dictionary);
+        test::Load(compacted, dictionary);
+        compacted.CompactTerms();
+        CHECK(compacted.WordCount() == words.WordCount());
+        for (int v = 0; v < 3; ++v)
+            CHECK(test::LookupAll(compacted, queries, (Verbosity)v, 2) == test::LookupAll(words, queries, (Verbosity)v, 2));
+        // term ids are ranks in sorted order
+        uint32_t id = 0;
+        for (size_t i = 0; i < dictionary.size(); i += 7)
+            CHECK(compacted.Terms().Find(dictionary[i].first, id) && compacted.Terms().Term(id) == dictionary[i].first);
+        for (uint32_t i = 1; i < compacted.Terms().Size(); ++i) CHECK(compacted.Terms().Term(i - 1) < compacted.Terms().Term(i));
+        CHECK(!compacted.Terms().Find("zzzz", id));
+    }
+}
+
+int main()
+{
+    CheckUnknown();
+    CheckQuantizeAfterCompact();
+    CheckCompactedLookups();
+    return test::Result();
+}
@@ -0,0 +1,110 @@
+#ifndef SYMSPELL_TESTUTILS_H
+#define SYMSPELL_TESTUTILS_H
+
+#include <iostream>
+#include <random>
+#include "../include/symspell.h"
+
+using namespace std;
+
+// Minimal checks for the ctest programs: a failed CHECK prints its location and the program exits
+// non-zero from Result(). The fixed dictionary and queries come from a seeded mt19937, whose output
+// is the same on every platform, so the expected results do not depend on the standard library.
+
+#define CHECK(condition) symspell::test::Check((condition), #condition, __FILE__, __LINE__)
+#define CHECK_THROWS(expression, exception)                         \
+    do {                                                            \
+        bool thrown = false;                                        \
+        try { expression; } catch (const exception&) { thrown = true; } \
+        symspell::test::Check(thrown, #expression " throws " #exception, __FILE__, __LINE__); \
+    } while (0)
+
+namespace symspell {
+namespace test {
+
+    inline int& Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void Check(bool ok, const char* text, const char* file, int line)
+    {
+        if (ok) return;
+        ++Failures();
+        cerr << file << ":" << line << ": check failed: " << text << endl;
+    }
+
+    inline int Result()
+    {
+        if (Failures() > 0) cerr << Failures() << " check(s) failed" << endl;
+        return Failures() == 0 ? 0 : 1;
+    }
+
+    /// <summary>words pseudo words of 2..11 letters over a small alphabet, so that many are within a few edits of each other.</summary>
+    inline vector<pair<string, long>> Dictionary(size_t words = 4000, uint32_t seed = 7)
+    {
+        const string letters = "aeioulnrstmkp";
+        mt19937 random(seed);
+        vector<pair<string, long>> dictionary;
+        for (size_t i = 0; i < words; ++i)
+        {
+            size_t length = 2 + random() % 10;
+            string word;
+            for (size_t j = 0; j < length; ++j) word += letters[random() % letters.size()];
+            // a narrow count range leaves some equal counts
+            dictionary.push_back(make_pair(word, (long)(1 + random() % 5000)));
+        }
+        return dictionary;
+    }
+
+    /// <summary>count dictionary words with one random delete, insert, replace or transpose, plus some exact words.</summary>
+    inline vector<string> Queries(const vector<pair<string, long>>& dictionary, size_t count = 1000, uint32_t seed = 11)
+    {
+        const string letters = "aeioulnrstmkpz";
+        mt19937 random(seed);
+        vector<string> queries;
+        for (size_t i = 0; i < count; ++i)
+        {
+            string word = dictionary[random() % dictionary.size()].first;
+            size_t position = random() % word.size();
+            switch (random() % 5)
+            {
+            case 0: word.erase(position, 1); break;
+            case 1: word.insert(position, 1, letters[random() % letters.size()]); break;
+            case 2: word[position] = letters[random() % letters.size()]; break;
+            case 3: if (position + 1 < word.size()) swap(word[position], word[position + 1]); break;
+            default: break;
+            }
+            queries.push_back(word);
+        }
+        return queries;
+    }
+
+    template <typename Engine>
+    void Load(Engine& engine, const vector<pair<string, long>>& dictionary)
+    {
+        for (size_t i = 0; i < dictionary.size(); ++i) engine.CreateDictionaryEntry(dictionary[i].first, dictionary[i].second);
+        engine.FinishLoading();
+    }
+
+    /// <summary>Suggestions of every query, one line per query: term:distance:count of each suggestion in order.</summary>
+    template <typename Engine>
+    string LookupAll(Engine& engine, const vector<string>& queries, Verbosity verbosity, int maxEditDistance)
+    {
+        string out;
+        vector<unique_ptr<SuggestItem>> items;
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            string query = queries[i];
+            engine.Lookup(query, verbosity, maxEditDistance, items);
+            for (size_t j = 0; j < items.size(); ++j)
+                out += items[j]->term + ":" + to_string(items[j]->distance) + ":" + to_string(items[j]->count) + " ";
+            out += "\n";
+        }
+        return out;
+    }
+}
+}
+
+#endif // SYMSPELL_TESTUTILS_H
@@ -0,0 +1,230 @@
+#include <iostream>
+#include <thread>
+#include "../bench/benchutils.h"
+#include "../include/symspell.h"
+#include "protocol.h"
+
+using namespace std;
+namespace protocol = symspell::protocol;
+
+// Load generator for symspell-server: C connections, each keeping up to D requests outstanding,
+// replay seeded misspellings of dictionary words. Prints a JSON report with throughput and
+// client side latency percentiles, plus the server's own stats with --stats.
+
+namespace {
+    struct Options
+    {
+        string dictionary;
+        string socketPath = "/tmp/symspell.sock";
+        int termIndex = 1;
+        int connections = 4;
+        int depth = 1;
+        size_t requests = 100000;
+        string op = "lookup";
+        int batchSize = 16;
+        int verbosity = (int)symspell::Verbosity::Top;
+        int maxEditDistance = defaultMaxEditDistance;
+        int typos = 1;
+        size_t distinct = 10000;
+        uint64_t seed = 42;
+        bool stats = false;
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> [--socket PATH] [--connections C] [--depth D] [--requests N]"
+             << " [--op lookup|batch|segment] [--batch-size B] [--verbosity top|closest|all] [--max-edit-distance D]"
+             << " [--typos E] [--distinct K] [--seed S] [--term-index I] [--stats]" << endl;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--socket" && hasValue) options.socketPath = argv[++i];
+            else if (arg == "--connections" && hasValue) options.connections = max(1, atoi(argv[++i]));
+            else if (arg == "--depth" && hasValue) options.depth = max(1, atoi(argv[++i]));
+            else if (arg == "--requests" && hasValue) options.requests = atol(argv[++i]);
+            else if (arg == "--op" && hasValue) options.op = argv[++i];
+            else if (arg == "--batch-size" && hasValue) options.batchSize = max(1, min(65535, atoi(argv[++i])));
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--typos" && hasValue) options.typos = atoi(argv[++i]);
+            else if (arg == "--distinct" && hasValue) options.distinct = max(1L, atol(argv[++i]));
+            else if (arg == "--seed" && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--term-index" && hasValue) options.termIndex = atoi(argv[++i]);
+            else if (arg == "--stats") options.stats = true;
+            else if (arg == "--verbosity" && hasValue)
+            {
+                string value = argv[++i];
+                if (value == "top") options.verbosity = (int)symspell::Verbosity::Top;
+                else if (value == "closest") options.verbosity = (int)symspell::Verbosity::Closest;
+                else if (value == "all") options.verbosity = (int)symspell::Verbosity::All;
+                else return false;
+            }
+            else if (arg.compare(0, 2, "--") != 0 && options.dictionary.empty()) options.dictionary = arg;
+            else return false;
+        }
+        return !options.dictionary.empty() && (options.op == "lookup" || options.op == "batch" || options.op == "segment");
+    }
+
+    struct ConnectionResult
+    {
+        vector<double> latencies;
+        size_t errors = 0;
+        size_t terms = 0;
+        bool failed = false;
+    };
+
+    void BuildRequest(const Options& options, const vector<string>& queries, uint32_t requestId, size_t& next, string& frame, size_t& terms)
+    {
+        frame.clear();
+        protocol::FrameWriter writer(frame);
+        if (options.op == "lookup")
+        {
+            writer.Begin(requestId, protocol::Lookup).U8((uint8_t)options.verbosity).U8((uint8_t)options.maxEditDistance).U8(0)
+                .Term(queries[next++ % queries.size()]);
+            terms = 1;
+        }
+        else if (options.op == "batch")
+        {
+            writer.Begin(requestId, protocol::Batch).U8((uint8_t)options.verbosity).U8((uint8_t)options.maxEditDistance).U16((uint16_t)options.batchSize);
+            for (int i = 0; i < options.batchSize; ++i) writer.Term(queries[next++ % queries.size()]);
+            terms = options.batchSize;
+        }
+        else
+        {
+            // four misspelled words with the spaces removed
+            string text;
+            for (int i = 0; i < 4; ++i) text += queries[next++ % queries.size()];
+            writer.Begin(requestId, protocol::Segment).U8((uint8_t)options.maxEditDistance).Text(text);
+            terms = 4;
+        }
+        writer.Finish();
+    }
+
+    void RunConnection(const Options& options, const vector<string>& queries, size_t quota, size_t offset, ConnectionResult& result)
+    {
+        int fd = protocol::Connect(options.socketPath);
+        if (fd < 0)
+        {
+            result.failed = true;
+            return;
+        }
+
+        vector<std::chrono::steady_clock::time_point> sentAt(quota);
+        result.latencies.reserve(quota);
+        size_t next = offset, sent = 0, received = 0;
+        string frame, response;
+        while (received < quota)
+        {
+            while (sent < quota && sent - received < (size_t)options.depth)
+            {
+                size_t terms = 0;
+                BuildRequest(options, queries, (uint32_t)sent, next, frame, terms);
+                sentAt[sent] = std::chrono::steady_clock::now();
+                if (!protocol::WriteAll(fd, frame.data(), frame.size())) { result.failed = true; close(fd); return; }
+                result.terms += terms;
+                ++sent;
+            }
+            if (!protocol::ReadFrame(fd, response)) { result.failed = true; close(fd); return; }
+            uint32_t requestId;
+            memcpy(&requestId, response.data() + 4, 4);
+            if ((uint8_t)response[8] != protocol::Ok) ++result.errors;
+            if (requestId < quota)
+                result.latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sentAt[requestId]).count());
+            ++received;
+        }
+        close(fd);
+    }
+
+    string FetchStats(const string& socketPath)
+    {
+        int fd = protocol::Connect(socketPath);
+        if (fd < 0) return string();
+        string frame, response, text;
+        protocol::FrameWriter writer(frame);
+        writer.Begin(0, protocol::Stats);
+        writer.Finish();
+        if (protocol::WriteAll(fd, frame.data(), frame.size()) && protocol::ReadFrame(fd, response))
+        {
+            protocol::FrameReader reader(response.data() + protocol::headerSize, response.size() - protocol::headerSize);
+            reader.Text(text);
+        }
+        close(fd);
+        return text;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    vector<string> terms = symspell::bench::ReadTerms(options.dictionary, options.termIndex);
+    if (terms.empty())
+    {
+        cerr << "no terms in " << options.dictionary << endl;
+        return 1;
+    }
+    vector<string> queries = symspell::bench::GenerateQueries(terms, options.distinct, options.typos, options.seed);
+
+    vector<ConnectionResult> results(options.connections);
+    vector<std::thread> threads;
+    size_t perConnection = options.requests / options.connections;
+    symspell::bench::Timer timer;
+    for (int c = 0; c < options.connections; ++c)
+    {
+        size_t quota = perConnection + ((size_t)c < options.requests % options.connections ? 1 : 0);
+        size_t offset = (size_t)c * queries.size() / options.connections;
+        threads.push_back(std::thread([&, c, quota, offset] { RunConnection(options, queries, quota, offset, results[c]); }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+    double seconds = timer.Seconds();
+
+    vector<double> latencies;
+    size_t errors = 0, lookedUp = 0, failed = 0;
+    for (size_t c = 0; c < results.size(); ++c)
+    {
+        latencies.insert(latencies.end(), results[c].latencies.begin(), results[c].latencies.end());
+        errors += results[c].errors;
+        lookedUp += results[c].terms;
+        if (results[c].failed) ++failed;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    symspell::bench::JsonWriter json;
+    json.BeginObject();
+    json.Value("socket", options.socketPath).Value("op", options.op).Value("connections", options.connections).Value("depth", options.depth)
+        .Value("requests", latencies.size()).Value("terms", lookedUp).Value("errors", errors).Value("failed_connections", failed)
+        .Value("seconds", seconds)
+        .Value("requests_per_s", seconds > 0 ? latencies.size() / seconds : 0.0)
+        .Value("terms_per_s", seconds > 0 ? lookedUp / seconds : 0.0);
+    json.BeginObject("latency_us")
+        .Value("p50", symspell::bench::Percentile(latencies, 0.5))
+        .Value("p90", symspell::bench::Percentile(latencies, 0.9))
+        .Value("p99", symspell::bench::Percentile(latencies, 0.99))
+        .Value("p999", symspell::bench::Percentile(latencies, 0.999))
+        .Value("max", latencies.empty() ? 0.0 : latencies.back())
+        .EndObject();
+    if (options.stats)
+    {
+        json.BeginObject("server");
+        std::stringstream ss(FetchStats(options.socketPath));
+        string line;
+        while (std::getline(ss, line))
+        {
+            size_t tab = line.find('\t');
+            if (tab != string::npos) json.Value(line.substr(0, tab).c_str(), atof(line.c_str() + tab + 1));
+        }
+        json.EndObject();
+    }
+    json.EndObject();
+    cout << json.str() << endl;
+    return failed == 0 ? 0 : 1;
+}
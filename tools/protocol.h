@@ -0,0 +1,241 @@
+#ifndef SYMSPELL_PROTOCOL_H
+#define SYMSPELL_PROTOCOL_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <errno.h>
+
+// Binary protocol of symspell-server. Every message is a frame:
+//
+//   uint32 length      bytes after this field
+//   uint32 requestId   chosen by the client, echoed in the response
+//   uint8  opcode      (request) / status (response)
+//   payload
+//
+// Integers are little endian, strings are a length followed by the bytes (uint16 for terms,
+// uint32 for texts). Request payloads:
+//
+//   Lookup   uint8 verbosity, uint8 maxEditDistance, uint8 includeUnknown, term
+//   Segment  uint8 maxEditDistance, text
+//   Batch    uint8 verbosity, uint8 maxEditDistance, uint16 count, count terms
+//   Stats    (empty)
+//
+// Response payloads (status Ok):
+//
+//   Lookup   suggestions: uint16 count, count x (term, uint8 distance, uint64 count)
+//   Segment  text segmented, text corrected, uint32 distanceSum, double probabilityLogSum
+//   Batch    uint16 count, count x suggestions
+//   Stats    text of "name\tvalue" lines
+//
+// Any other status carries a text message.
+
+namespace symspell {
+namespace protocol {
+
+    enum Opcode : uint8_t
+    {
+        Lookup = 1,
+        Segment = 2,
+        Batch = 3,
+        Stats = 4
+    };
+
+    enum Status : uint8_t
+    {
+        Ok = 0,
+        BadRequest = 1,
+        Error = 2
+    };
+
+    const size_t headerSize = 9;
+    const uint32_t maxFrameLength = 16 << 20;
+
+    struct Suggestion
+    {
+        std::string term;
+        int distance;
+        uint64_t count;
+    };
+
+    /// <summary>Appends little endian fields to a frame; Finish() fills in the length.</summary>
+    class FrameWriter
+    {
+    public:
+        explicit FrameWriter(std::string& out) : out(out), start(out.size()) { }
+
+        FrameWriter& Begin(uint32_t requestId, uint8_t code)
+        {
+            U32(0);
+            U32(requestId);
+            return U8(code);
+        }
+
+        FrameWriter& U8(uint8_t value) { out += (char)value; return *this; }
+        FrameWriter& U16(uint16_t value) { return Bytes(&value, 2); }
+        FrameWriter& U32(uint32_t value) { return Bytes(&value, 4); }
+        FrameWriter& U64(uint64_t value) { return Bytes(&value, 8); }
+        FrameWriter& F64(double value) { return Bytes(&value, 8); }
+        FrameWriter& Term(const std::string& value) { U16((uint16_t)value.size()); out += value; return *this; }
+        FrameWriter& Text(const std::string& value) { U32((uint32_t)value.size()); out += value; return *this; }
+
+        void Finish()
+        {
+            uint32_t length = (uint32_t)(out.size() - start - 4);
+            std::memcpy(&out[start], &length, 4);
+        }
+
+    private:
+        // the protocol is little endian, as are the hosts it runs on
+        FrameWriter& Bytes(const void* value, size_t size) { out.append((const char*)value, size); return *this; }
+
+        std::string& out;
+        size_t start;
+    };
+
+    /// <summary>Bounds checked reader over one frame payload; every read fails once the payload is exhausted.</summary>
+    class FrameReader
+    {
+    public:
+        FrameReader(const char* data, size_t size) : p(data), end(data + size) { }
+
+        bool U8(uint8_t& value) { return Bytes(&value, 1); }
+        bool U16(uint16_t& value) { return Bytes(&value, 2); }
+        bool U32(uint32_t& value) { return Bytes(&value, 4); }
+        bool U64(uint64_t& value) { return Bytes(&value, 8); }
+        bool F64(double& value) { return Bytes(&value, 8); }
+        bool Term(std::string& value) { uint16_t size; return U16(size) && String(value, size); }
+        bool Text(std::string& value) { uint32_t size; return U32(size) && String(value, size); }
+        bool AtEnd() const { return p == end; }
+
+    private:
+        bool Bytes(void* value, size_t size)
+        {
+            if ((size_t)(end - p) < size) return false;
+            std::memcpy(value, p, size);
+            p += size;
+            return true;
+        }
+
+        bool String(std::string& value, size_t size)
+        {
+            if ((size_t)(end - p) < size) return false;
+            value.assign(p, size);
+            p += size;
+            return true;
+        }
+
+        const char* p;
+        const char* end;
+    };
+
+    inline const Suggestion& SuggestionOf(const Suggestion& suggestion) { return suggestion; }
+    template <typename Item>
+    inline const Item& SuggestionOf(const std::unique_ptr<Item>& suggestion) { return *suggestion; }
+
+    /// <summary>Writes suggestions (Suggestion values or unique_ptrs to SuggestItem), at most UINT16_MAX of them.</summary>
+    template <typename Suggestions>
+    inline void WriteSuggestions(FrameWriter& writer, const Suggestions& suggestions)
+    {
+        size_t count = std::min(suggestions.size(), (size_t)UINT16_MAX);
+        writer.U16((uint16_t)count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto& suggestion = SuggestionOf(suggestions[i]);
+            writer.Term(suggestion.term).U8((uint8_t)suggestion.distance).U64((uint64_t)suggestion.count);
+        }
+    }
+
+    inline bool ReadSuggestions(FrameReader& reader, std::vector<Suggestion>& suggestions)
+    {
+        uint16_t count;
+        if (!reader.U16(count)) return false;
+        suggestions.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint8_t distance;
+            if (!reader.Term(suggestions[i].term) || !reader.U8(distance) || !reader.U64(suggestions[i].count)) return false;
+            suggestions[i].distance = distance;
+        }
+        return true;
+    }
+
+    /// <summary>Length of the first complete frame in buffer (header included), 0 if more bytes are needed.</summary>
+    inline size_t CompleteFrame(const char* buffer, size_t size)
+    {
+        if (size < 4) return 0;
+        uint32_t length;
+        std::memcpy(&length, buffer, 4);
+        return size - 4 >= length ? length + 4 : 0;
+    }
+
+    inline uint32_t FrameLength(const char* buffer)
+    {
+        uint32_t length;
+        std::memcpy(&length, buffer, 4);
+        return length;
+    }
+
+    /// <summary>Connects a blocking stream socket to path, -1 on failure.</summary>
+    inline int Connect(const std::string& path)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    inline bool WriteAll(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written = write(fd, data, size);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            data += written;
+            size -= (size_t)written;
+        }
+        return true;
+    }
+
+    /// <summary>Blocking read of one frame into frame (header included).</summary>
+    inline bool ReadFrame(int fd, std::string& frame)
+    {
+        frame.resize(4);
+        size_t have = 0;
+        size_t need = 4;
+        while (have < need)
+        {
+            ssize_t got = read(fd, &frame[have], need - have);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+            have += (size_t)got;
+            if (have == 4 && need == 4)
+            {
+                uint32_t length = FrameLength(frame.data());
+                if (length < headerSize - 4 || length > maxFrameLength) return false;
+                need = 4 + length;
+                frame.resize(need);
+            }
+        }
+        return true;
+    }
+}
+}
+
+#endif // SYMSPELL_PROTOCOL_H
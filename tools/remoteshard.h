@@ -0,0 +1,52 @@
+#ifndef SYMSPELL_REMOTESHARD_H
+#define SYMSPELL_REMOTESHARD_H
+
+#include <stdexcept>
+#include "../include/shardedsymspell.h"
+#include "protocol.h"
+
+namespace symspell {
+
+/// <summary>Shard served by a symspell-server process (started with --shard i/K) on a Unix domain socket.</summary>
+/// Start sends the Lookup request and Finish waits for its response, so a coordinator talks to all
+/// its remote shards at once. One connection per shard; not safe for concurrent lookups.
+class RemoteShard : public Shard
+{
+public:
+    explicit RemoteShard(const std::string& socketPath)
+    {
+        fd = protocol::Connect(socketPath);
+        if (fd < 0) throw std::runtime_error("cannot connect to " + socketPath);
+    }
+
+    ~RemoteShard() { close(fd); }
+
+    void Start(const std::string& input, Verbosity verbosity, int maxEditDistance)
+    {
+        frame.clear();
+        protocol::FrameWriter writer(frame);
+        writer.Begin(++requestId, protocol::Lookup).U8((uint8_t)verbosity).U8((uint8_t)maxEditDistance).U8(0).Term(input);
+        writer.Finish();
+        if (!protocol::WriteAll(fd, frame.data(), frame.size())) throw std::runtime_error("shard connection lost");
+    }
+
+    void Finish(std::vector<std::unique_ptr<symspell::SuggestItem>> & items)
+    {
+        items.clear();
+        if (!protocol::ReadFrame(fd, frame)) throw std::runtime_error("shard connection lost");
+        if ((uint8_t)frame[8] != protocol::Ok) throw std::runtime_error("shard rejected the lookup");
+        protocol::FrameReader reader(frame.data() + protocol::headerSize, frame.size() - protocol::headerSize);
+        if (!protocol::ReadSuggestions(reader, suggestions)) throw std::runtime_error("malformed shard response");
+        for (size_t i = 0; i < suggestions.size(); ++i)
+            items.push_back(std::unique_ptr<SuggestItem>(new SuggestItem(suggestions[i].term, suggestions[i].distance, (long)suggestions[i].count)));
+    }
+
+private:
+    int fd;
+    uint32_t requestId = 0;
+    std::string frame;
+    std::vector<protocol::Suggestion> suggestions;
+};
+}
+
+#endif // SYMSPELL_REMOTESHARD_H
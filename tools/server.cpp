@@ -0,0 +1,703 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "../include/shardedsymspell.h"
+#include "protocol.h"
+
+using namespace std;
+namespace protocol = symspell::protocol;
+
+// Spell checking daemon: one loaded dictionary served over a Unix domain socket (see protocol.h).
+//
+// The epoll loop thread owns every connection: it reads frames, answers Stats itself and queues
+// the rest as jobs. Identical Lookup and Segment requests in flight share one job. Worker
+// threads take up to --max-batch queued jobs at a time (optionally waiting --batch-window-us for
+// the batch to fill), run them, and hand all their responses back to the loop in one step
+// through an eventfd.
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    volatile sig_atomic_t stopping = 0;
+    int wakeFd = -1;
+
+    void OnSignal(int)
+    {
+        stopping = 1;
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    struct Options
+    {
+        string dictionary;
+        string socketPath = "/tmp/symspell.sock";
+        int termIndex = 1;
+        int countIndex = 0;
+        int threads = max(1, (int)std::thread::hardware_concurrency());
+        int maxEditDistance = defaultMaxEditDistance;
+        int prefixLength = defaultPrefixLength;
+        size_t maxBatch = 64;
+        int batchWindowUs = 0;
+        // serve only the words of shard `shard` out of `shards` (see ShardedSymSpell)
+        size_t shard = 0;
+        size_t shards = 1;
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> [--socket PATH] [--threads N] [--max-edit-distance D] [--prefix-length P]"
+             << " [--term-index I] [--count-index I] [--max-batch N] [--batch-window-us U] [--shard I/K]" << endl;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--socket" && hasValue) options.socketPath = argv[++i];
+            else if (arg == "--threads" && hasValue) options.threads = max(1, atoi(argv[++i]));
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--prefix-length" && hasValue) options.prefixLength = atoi(argv[++i]);
+            else if (arg == "--term-index" && hasValue) options.termIndex = atoi(argv[++i]);
+            else if (arg == "--count-index" && hasValue) options.countIndex = atoi(argv[++i]);
+            else if (arg == "--max-batch" && hasValue) options.maxBatch = (size_t)max(1, atoi(argv[++i]));
+            else if (arg == "--batch-window-us" && hasValue) options.batchWindowUs = max(0, atoi(argv[++i]));
+            else if (arg == "--shard" && hasValue)
+            {
+                string value = argv[++i];
+                size_t slash = value.find('/');
+                if (slash == string::npos) return false;
+                options.shard = (size_t)atol(value.c_str());
+                options.shards = (size_t)atol(value.c_str() + slash + 1);
+                if (options.shards < 1 || options.shard >= options.shards) return false;
+            }
+            else if (arg.compare(0, 2, "--") != 0 && options.dictionary.empty()) options.dictionary = arg;
+            else return false;
+        }
+        return !options.dictionary.empty();
+    }
+
+    /// <summary>Request waiting for the result of a job.</summary>
+    struct Waiter
+    {
+        uint64_t connection;
+        uint32_t requestId;
+        Clock::time_point received;
+    };
+
+    struct Job
+    {
+        uint8_t opcode = 0;
+        uint8_t verbosity = 0;
+        uint8_t maxEditDistance = 0;
+        bool includeUnknown = false;
+        string text;
+        vector<string> terms;
+        // in flight key shared by identical requests (empty for Batch, which is never shared)
+        string key;
+        Waiter waiter;
+    };
+
+    struct Completion
+    {
+        uint64_t connection;
+        string frame;
+    };
+
+    struct Connection
+    {
+        int fd = -1;
+        uint64_t id = 0;
+        string in;
+        string out;
+        size_t outOffset = 0;
+        bool writing = false;
+        bool reading = true;
+        // the client shut down its write side; closed once every reply is out
+        bool readClosed = false;
+        // requests handed to the workers and not delivered yet
+        size_t pending = 0;
+    };
+
+    /// <summary>Server side latency histogram with power of two microsecond buckets.</summary>
+    class LatencyHistogram
+    {
+    public:
+        LatencyHistogram() { for (size_t i = 0; i < buckets; ++i) counts[i] = 0; }
+
+        void Add(double microseconds)
+        {
+            size_t index = 0;
+            uint64_t value = (uint64_t)microseconds;
+            while (value > 0 && index + 1 < buckets) { value >>= 1; ++index; }
+            counts[index].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// <summary>Upper bound of the bucket holding quantile q.</summary>
+        double Percentile(double q) const
+        {
+            uint64_t total = 0;
+            for (size_t i = 0; i < buckets; ++i) total += counts[i].load(std::memory_order_relaxed);
+            if (total == 0) return 0;
+            uint64_t rank = (uint64_t)(q * (total - 1)) + 1, seen = 0;
+            for (size_t i = 0; i < buckets; ++i)
+            {
+                seen += counts[i].load(std::memory_order_relaxed);
+                if (seen >= rank) return (double)((uint64_t)1 << i);
+            }
+            return (double)((uint64_t)1 << (buckets - 1));
+        }
+
+    private:
+        static const size_t buckets = 40;
+        std::atomic<uint64_t> counts[buckets];
+    };
+
+    class Server
+    {
+    public:
+        Server(const Options& options, symspell::SymSpell& symSpell) : options(options), symSpell(symSpell), started(Clock::now()) { }
+
+        int Run();
+
+    private:
+        // loop thread
+        void Accept();
+        void Read(Connection& connection);
+        bool Dispatch(Connection& connection, const char* frame, size_t size);
+        void Respond(Connection& connection, uint32_t requestId, uint8_t status, const string& body);
+        void Flush(Connection& connection);
+        void Close(Connection& connection);
+        void Deliver();
+        string StatsText();
+
+        // loop thread -> workers
+        void Submit(Job& job);
+        // workers
+        void Work();
+        string Execute(const Job& job);
+        void SetEvents(Connection& connection);
+
+        const Options& options;
+        symspell::SymSpell& symSpell;
+        Clock::time_point started;
+
+        int listenFd = -1;
+        int epollFd = -1;
+        uint64_t nextConnectionId = 1;
+        unordered_map<int, Connection> connections;
+        unordered_map<uint64_t, int> connectionFds;
+
+        mutex jobsMutex;
+        condition_variable jobsChanged;
+        deque<Job> jobs;
+        unordered_map<string, vector<Waiter>> inFlight;
+        bool shuttingDown = false;
+
+        mutex completionsMutex;
+        vector<Completion> completions;
+
+        std::atomic<uint64_t> connectionsAccepted{ 0 };
+        std::atomic<uint64_t> requests[5];
+        std::atomic<uint64_t> badRequests{ 0 };
+        std::atomic<uint64_t> sharedRequests{ 0 };
+        std::atomic<uint64_t> computations{ 0 };
+        std::atomic<uint64_t> batches{ 0 };
+        std::atomic<uint64_t> batchedJobs{ 0 };
+        std::atomic<uint64_t> largestBatch{ 0 };
+        LatencyHistogram latency;
+    };
+
+    string Frame(uint32_t requestId, uint8_t status, const string& body)
+    {
+        string frame;
+        frame.reserve(protocol::headerSize + body.size());
+        protocol::FrameWriter writer(frame);
+        writer.Begin(requestId, status);
+        frame += body;
+        writer.Finish();
+        return frame;
+    }
+
+    int Server::Run()
+    {
+        for (size_t i = 0; i < 5; ++i) requests[i] = 0;
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (options.socketPath.size() >= sizeof(address.sun_path))
+        {
+            cerr << "socket path too long" << endl;
+            return 1;
+        }
+        strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+        unlink(options.socketPath.c_str());
+        if (listenFd < 0 || bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 128) != 0)
+        {
+            cerr << "cannot listen on " << options.socketPath << ": " << strerror(errno) << endl;
+            return 1;
+        }
+
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+        event.data.fd = wakeFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+        signal(SIGINT, OnSignal);
+        signal(SIGTERM, OnSignal);
+        signal(SIGPIPE, SIG_IGN);
+
+        vector<std::thread> workers;
+        for (int t = 0; t < options.threads; ++t) workers.push_back(std::thread([this] { Work(); }));
+        cerr << "listening on " << options.socketPath << " with " << options.threads << " workers" << endl;
+
+        vector<epoll_event> events(256);
+        while (!stopping)
+        {
+            int ready = epoll_wait(epollFd, events.data(), (int)events.size(), 1000);
+            if (ready < 0 && errno != EINTR) break;
+            for (int i = 0; i < ready; ++i)
+            {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) Accept();
+                else if (fd == wakeFd) Deliver();
+                else
+                {
+                    auto finded = connections.find(fd);
+                    if (finded == connections.end()) continue;
+                    if (events[i].events & EPOLLOUT) Flush(finded->second);
+                    // Flush closes the connection on write errors
+                    finded = connections.find(fd);
+                    if (finded == connections.end()) continue;
+                    if (events[i].events & EPOLLIN) Read(finded->second);
+                    else if (events[i].events & (EPOLLERR | EPOLLHUP)) Close(finded->second);
+                }
+            }
+        }
+
+        {
+            lock_guard<mutex> lock(jobsMutex);
+            shuttingDown = true;
+            jobsChanged.notify_all();
+        }
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+        while (!connections.empty()) Close(connections.begin()->second);
+        close(listenFd);
+        close(epollFd);
+        unlink(options.socketPath.c_str());
+        cerr << StatsText();
+        return 0;
+    }
+
+    void Server::Accept()
+    {
+        while (true)
+        {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            Connection& connection = connections[fd];
+            connection.fd = fd;
+            connection.id = nextConnectionId++;
+            connectionFds[connection.id] = fd;
+            epoll_event event;
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+            ++connectionsAccepted;
+        }
+    }
+
+    void Server::Read(Connection& connection)
+    {
+        char buffer[65536];
+        while (true)
+        {
+            ssize_t got = read(connection.fd, buffer, sizeof(buffer));
+            if (got > 0) { connection.in.append(buffer, (size_t)got); continue; }
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (got < 0)
+            {
+                Close(connection);
+                return;
+            }
+            // end of input: answer the complete requests already received, Flush closes once they are out
+            connection.readClosed = true;
+            break;
+        }
+
+        size_t consumed = 0;
+        while (true)
+        {
+            const char* data = connection.in.data() + consumed;
+            size_t available = connection.in.size() - consumed;
+            if (available >= 4)
+            {
+                uint32_t length = protocol::FrameLength(data);
+                if (length < protocol::headerSize - 4 || length > protocol::maxFrameLength)
+                {
+                    Close(connection);
+                    return;
+                }
+            }
+            size_t size = protocol::CompleteFrame(data, available);
+            if (size == 0) break;
+            if (!Dispatch(connection, data, size))
+            {
+                Close(connection);
+                return;
+            }
+            consumed += size;
+        }
+        connection.in.erase(0, consumed);
+        Flush(connection);
+    }
+
+    bool Server::Dispatch(Connection& connection, const char* frame, size_t size)
+    {
+        uint32_t requestId;
+        uint8_t opcode;
+        memcpy(&requestId, frame + 4, 4);
+        opcode = (uint8_t)frame[8];
+        protocol::FrameReader reader(frame + protocol::headerSize, size - protocol::headerSize);
+
+        Job job;
+        job.opcode = opcode;
+        job.waiter.connection = connection.id;
+        job.waiter.requestId = requestId;
+        job.waiter.received = Clock::now();
+        bool valid = false;
+        switch (opcode)
+        {
+        case protocol::Lookup:
+        {
+            uint8_t includeUnknown = 0;
+            valid = reader.U8(job.verbosity) && reader.U8(job.maxEditDistance) && reader.U8(includeUnknown) && reader.Term(job.text) && reader.AtEnd();
+            job.includeUnknown = includeUnknown != 0;
+            break;
+        }
+        case protocol::Segment:
+            valid = reader.U8(job.maxEditDistance) && reader.Text(job.text) && reader.AtEnd();
+            break;
+        case protocol::Batch:
+        {
+            uint16_t count;
+            valid = reader.U8(job.verbosity) && reader.U8(job.maxEditDistance) && reader.U16(count);
+            job.terms.resize(valid ? count : 0);
+            for (size_t i = 0; valid && i < job.terms.size(); ++i) valid = reader.Term(job.terms[i]);
+            valid = valid && reader.AtEnd();
+            break;
+        }
+        case protocol::Stats:
+        {
+            ++requests[protocol::Stats];
+            string body;
+            protocol::FrameWriter(body).Text(StatsText());
+            Respond(connection, requestId, protocol::Ok, body);
+            return true;
+        }
+        default:
+            break;
+        }
+
+        if (valid && (job.verbosity > (uint8_t)symspell::Verbosity::All || job.maxEditDistance > symSpell.MaxDictionaryEditDistance()))
+            valid = false;
+        if (!valid)
+        {
+            ++badRequests;
+            string message;
+            protocol::FrameWriter(message).Text("malformed request or parameters out of range");
+            Respond(connection, requestId, protocol::BadRequest, message);
+            return true;
+        }
+
+        ++requests[opcode];
+        if (opcode != protocol::Batch)
+        {
+            job.key.reserve(job.text.size() + 4);
+            job.key += (char)opcode;
+            job.key += (char)job.verbosity;
+            job.key += (char)job.maxEditDistance;
+            job.key += (char)job.includeUnknown;
+            job.key += job.text;
+        }
+        Submit(job);
+        ++connection.pending;
+        return true;
+    }
+
+    void Server::Submit(Job& job)
+    {
+        lock_guard<mutex> lock(jobsMutex);
+        if (!job.key.empty())
+        {
+            auto finded = inFlight.find(job.key);
+            if (finded != inFlight.end())
+            {
+                // the same query is queued or running: wait for its result instead of computing it again
+                finded->second.push_back(job.waiter);
+                ++sharedRequests;
+                return;
+            }
+            inFlight[job.key].push_back(job.waiter);
+        }
+        jobs.push_back(std::move(job));
+        jobsChanged.notify_one();
+    }
+
+    void Server::Work()
+    {
+        vector<Job> batch;
+        vector<Completion> done;
+        while (true)
+        {
+            batch.clear();
+            {
+                unique_lock<mutex> lock(jobsMutex);
+                jobsChanged.wait(lock, [this] { return !jobs.empty() || shuttingDown; });
+                if (shuttingDown) return;
+                if (options.batchWindowUs > 0 && jobs.size() < options.maxBatch)
+                    jobsChanged.wait_for(lock, std::chrono::microseconds(options.batchWindowUs), [this] { return jobs.size() >= options.maxBatch || shuttingDown; });
+                while (!jobs.empty() && batch.size() < options.maxBatch)
+                {
+                    batch.push_back(std::move(jobs.front()));
+                    jobs.pop_front();
+                }
+            }
+            if (batch.empty()) continue;
+
+            ++batches;
+            batchedJobs += batch.size();
+            uint64_t largest = largestBatch.load();
+            while (batch.size() > largest && !largestBatch.compare_exchange_weak(largest, batch.size())) { }
+
+            done.clear();
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                string body = Execute(batch[i]);
+                ++computations;
+
+                vector<Waiter> waiters;
+                if (batch[i].key.empty()) waiters.push_back(batch[i].waiter);
+                else
+                {
+                    lock_guard<mutex> lock(jobsMutex);
+                    auto finded = inFlight.find(batch[i].key);
+                    waiters.swap(finded->second);
+                    inFlight.erase(finded);
+                }
+
+                Clock::time_point now = Clock::now();
+                for (size_t w = 0; w < waiters.size(); ++w)
+                {
+                    Completion completion;
+                    completion.connection = waiters[w].connection;
+                    completion.frame = Frame(waiters[w].requestId, protocol::Ok, body);
+                    done.push_back(std::move(completion));
+                    latency.Add(std::chrono::duration<double, std::micro>(now - waiters[w].received).count());
+                }
+            }
+
+            // one handover and one wakeup of the loop per batch
+            {
+                lock_guard<mutex> lock(completionsMutex);
+                for (size_t i = 0; i < done.size(); ++i) completions.push_back(std::move(done[i]));
+            }
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+
+    string Server::Execute(const Job& job)
+    {
+        string body;
+        protocol::FrameWriter writer(body);
+        vector<std::unique_ptr<symspell::SuggestItem>> items;
+        symspell::Verbosity verbosity = (symspell::Verbosity)job.verbosity;
+        switch (job.opcode)
+        {
+        case protocol::Lookup:
+        {
+            string term = job.text;
+            symSpell.Lookup(term, verbosity, job.maxEditDistance, job.includeUnknown, items);
+            protocol::WriteSuggestions(writer, items);
+            break;
+        }
+        case protocol::Batch:
+        {
+            writer.U16((uint16_t)job.terms.size());
+            for (size_t t = 0; t < job.terms.size(); ++t)
+            {
+                string term = job.terms[t];
+                symSpell.Lookup(term, verbosity, job.maxEditDistance, items);
+                protocol::WriteSuggestions(writer, items);
+            }
+            break;
+        }
+        case protocol::Segment:
+        {
+            string text = job.text;
+            shared_ptr<symspell::WordSegmentationItem> segmentation = symSpell.WordSegmentation(text, job.maxEditDistance);
+            writer.Text(segmentation->segmentedString).Text(segmentation->correctedString)
+                .U32((uint32_t)segmentation->distanceSum).F64(segmentation->probabilityLogSum);
+            break;
+        }
+        }
+        return body;
+    }
+
+    void Server::Deliver()
+    {
+        uint64_t counter;
+        ssize_t ignored = read(wakeFd, &counter, sizeof(counter));
+        (void)ignored;
+
+        vector<Completion> ready;
+        {
+            lock_guard<mutex> lock(completionsMutex);
+            ready.swap(completions);
+        }
+        vector<int> touched;
+        for (size_t i = 0; i < ready.size(); ++i)
+        {
+            auto fd = connectionFds.find(ready[i].connection);
+            if (fd == connectionFds.end()) continue; // client went away meanwhile
+            Connection& connection = connections[fd->second];
+            if (connection.out.size() == connection.outOffset) touched.push_back(fd->second);
+            connection.out += ready[i].frame;
+            --connection.pending;
+        }
+        for (size_t i = 0; i < touched.size(); ++i)
+        {
+            auto finded = connections.find(touched[i]);
+            if (finded != connections.end()) Flush(finded->second);
+        }
+    }
+
+    void Server::Respond(Connection& connection, uint32_t requestId, uint8_t status, const string& body)
+    {
+        connection.out += Frame(requestId, status, body);
+    }
+
+    void Server::Flush(Connection& connection)
+    {
+        while (connection.outOffset < connection.out.size())
+        {
+            ssize_t written = write(connection.fd, connection.out.data() + connection.outOffset, connection.out.size() - connection.outOffset);
+            if (written > 0) { connection.outOffset += (size_t)written; continue; }
+            if (written < 0 && errno == EINTR) continue;
+            if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            Close(connection);
+            return;
+        }
+        if (connection.outOffset == connection.out.size())
+        {
+            connection.out.clear();
+            connection.outOffset = 0;
+        }
+        if (connection.readClosed && connection.pending == 0 && connection.out.empty())
+        {
+            Close(connection);
+            return;
+        }
+        SetEvents(connection);
+    }
+
+    void Server::SetEvents(Connection& connection)
+    {
+        bool writing = !connection.out.empty();
+        // after end of input, EPOLLIN would report the end again on every wait
+        bool reading = !connection.readClosed;
+        if (connection.writing == writing && connection.reading == reading) return;
+        connection.writing = writing;
+        connection.reading = reading;
+        epoll_event event;
+        event.events = (reading ? uint32_t(EPOLLIN) : 0u) | (writing ? uint32_t(EPOLLOUT) : 0u);
+        event.data.fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+
+    void Server::Close(Connection& connection)
+    {
+        int fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connectionFds.erase(connection.id);
+        connections.erase(fd);
+    }
+
+    string Server::StatsText()
+    {
+        size_t queued;
+        {
+            lock_guard<mutex> lock(jobsMutex);
+            queued = jobs.size();
+        }
+        uint64_t batchCount = batches.load();
+        std::stringstream ss;
+        ss << "uptime_s\t" << std::chrono::duration<double>(Clock::now() - started).count() << "\n"
+           << "words\t" << symSpell.WordCount() << "\n"
+           << "shard\t" << options.shard << "\n"
+           << "shards\t" << options.shards << "\n"
+           << "workers\t" << options.threads << "\n"
+           << "connections_accepted\t" << connectionsAccepted.load() << "\n"
+           << "connections_open\t" << connections.size() << "\n"
+           << "requests_lookup\t" << requests[protocol::Lookup].load() << "\n"
+           << "requests_segment\t" << requests[protocol::Segment].load() << "\n"
+           << "requests_batch\t" << requests[protocol::Batch].load() << "\n"
+           << "requests_stats\t" << requests[protocol::Stats].load() << "\n"
+           << "bad_requests\t" << badRequests.load() << "\n"
+           << "shared_requests\t" << sharedRequests.load() << "\n"
+           << "computations\t" << computations.load() << "\n"
+           << "batches\t" << batchCount << "\n"
+           << "mean_batch\t" << (batchCount == 0 ? 0.0 : (double)batchedJobs.load() / batchCount) << "\n"
+           << "largest_batch\t" << largestBatch.load() << "\n"
+           << "queued\t" << queued << "\n"
+           << "latency_p50_us\t" << latency.Percentile(0.5) << "\n"
+           << "latency_p99_us\t" << latency.Percentile(0.99) << "\n"
+           << "latency_max_us\t" << latency.Percentile(1.0) << "\n";
+        if (symspell::LookupStatsRegistry::Enabled()) ss << symspell::LookupStatsRegistry::Snapshot().ToString();
+        return ss.str();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    symspell::SymSpell symSpell(defaultInitialCapacity, options.maxEditDistance, options.prefixLength);
+    bool loaded = options.shards > 1
+        ? symspell::ShardedSymSpell::LoadDictionaryShard(symSpell, options.dictionary, options.termIndex, options.countIndex, options.shard, options.shards)
+        : symSpell.LoadDictionary(options.dictionary, options.termIndex, options.countIndex);
+    if (!loaded)
+    {
+        cerr << "cannot read " << options.dictionary << endl;
+        return 1;
+    }
+
+    Server server(options, symSpell);
+    return server.Run();
+}
@@ -0,0 +1,162 @@
+#include <iostream>
+#include "../bench/benchutils.h"
+#include "../include/shardedsymspell.h"
+#include "remoteshard.h"
+
+using namespace std;
+
+// Checks that a sharded dictionary answers exactly like one unsharded index: the same seeded
+// misspellings are looked up in both for every verbosity and number of typos, and any difference
+// is printed. Shards are built in process (--shards K) or reached through symspell-server
+// instances started with --shard i/K (--sockets a,b,...). Prints a JSON summary.
+
+namespace {
+    struct Options
+    {
+        string dictionary;
+        int termIndex = 1;
+        int countIndex = 0;
+        size_t shards = 4;
+        vector<string> sockets;
+        size_t queries = 2000;
+        uint64_t seed = 42;
+        int maxEditDistance = defaultMaxEditDistance;
+        int prefixLength = defaultPrefixLength;
+    };
+
+    void Usage(const char* program)
+    {
+        cerr << "usage: " << program << " <dictionary> [--shards K | --sockets PATH,PATH,...] [--queries N] [--seed S]"
+             << " [--max-edit-distance D] [--prefix-length P] [--term-index I] [--count-index I]" << endl;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--shards" && hasValue) options.shards = (size_t)max(1, atoi(argv[++i]));
+            else if (arg == "--sockets" && hasValue)
+            {
+                std::stringstream ss(argv[++i]);
+                string path;
+                while (std::getline(ss, path, ',')) if (!path.empty()) options.sockets.push_back(path);
+            }
+            else if (arg == "--queries" && hasValue) options.queries = atol(argv[++i]);
+            else if (arg == "--seed" && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--max-edit-distance" && hasValue) options.maxEditDistance = atoi(argv[++i]);
+            else if (arg == "--prefix-length" && hasValue) options.prefixLength = atoi(argv[++i]);
+            else if (arg == "--term-index" && hasValue) options.termIndex = atoi(argv[++i]);
+            else if (arg == "--count-index" && hasValue) options.countIndex = atoi(argv[++i]);
+            else if (arg.compare(0, 2, "--") != 0 && options.dictionary.empty()) options.dictionary = arg;
+            else return false;
+        }
+        return !options.dictionary.empty();
+    }
+
+    // Suggestions as comparable text. Suggestions tied on distance and count may come in any order,
+    // and Top may pick any of them, so ties are sorted by term and Top keeps only distance and count.
+    string Describe(vector<std::unique_ptr<symspell::SuggestItem>>& items, symspell::Verbosity verbosity)
+    {
+        std::stable_sort(items.begin(), items.end(), [](const std::unique_ptr<symspell::SuggestItem>& l, const std::unique_ptr<symspell::SuggestItem>& r)
+        {
+            if (l->distance != r->distance) return l->distance < r->distance;
+            if (l->count != r->count) return l->count > r->count;
+            return l->term < r->term;
+        });
+        std::stringstream ss;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (verbosity != symspell::Verbosity::Top) ss << items[i]->term << "/";
+            ss << items[i]->distance << "/" << items[i]->count << " ";
+        }
+        return ss.str();
+    }
+
+    const char* VerbosityName(symspell::Verbosity verbosity)
+    {
+        switch (verbosity)
+        {
+        case symspell::Verbosity::Top: return "top";
+        case symspell::Verbosity::Closest: return "closest";
+        default: return "all";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    symspell::SymSpell single(defaultInitialCapacity, options.maxEditDistance, options.prefixLength);
+    if (!single.LoadDictionary(options.dictionary, options.termIndex, options.countIndex))
+    {
+        cerr << "cannot read " << options.dictionary << endl;
+        return 1;
+    }
+
+    std::unique_ptr<symspell::ShardedSymSpell> sharded;
+    if (options.sockets.empty())
+    {
+        sharded.reset(new symspell::ShardedSymSpell(options.shards, options.maxEditDistance, options.prefixLength));
+        sharded->LoadDictionary(options.dictionary, options.termIndex, options.countIndex);
+    }
+    else
+    {
+        vector<std::unique_ptr<symspell::Shard>> shards;
+        for (size_t i = 0; i < options.sockets.size(); ++i)
+            shards.push_back(std::unique_ptr<symspell::Shard>(new symspell::RemoteShard(options.sockets[i])));
+        sharded.reset(new symspell::ShardedSymSpell(std::move(shards), options.maxEditDistance));
+    }
+
+    vector<string> terms = symspell::bench::ReadTerms(options.dictionary, options.termIndex);
+    symspell::bench::JsonWriter json;
+    json.BeginObject();
+    json.Value("dictionary", options.dictionary).Value("shards", sharded->ShardCount())
+        .Value("remote", options.sockets.empty() ? "no" : "yes").Value("queries", options.queries);
+    json.BeginArray("runs");
+
+    size_t totalMismatches = 0;
+    symspell::Verbosity verbosities[] = { symspell::Verbosity::Top, symspell::Verbosity::Closest, symspell::Verbosity::All };
+    vector<std::unique_ptr<symspell::SuggestItem>> expected, actual;
+    for (int edits = 0; edits <= options.maxEditDistance + 1; ++edits)
+    {
+        vector<string> queries = symspell::bench::GenerateQueries(terms, options.queries, edits, options.seed + edits);
+        for (size_t v = 0; v < 3; ++v)
+        {
+            size_t mismatches = 0;
+            double singleNs = 0, shardedNs = 0;
+            for (size_t q = 0; q < queries.size(); ++q)
+            {
+                symspell::bench::Timer timer;
+                single.Lookup(queries[q], verbosities[v], options.maxEditDistance, true, expected);
+                singleNs += timer.Nanoseconds();
+                timer.Reset();
+                sharded->Lookup(queries[q], verbosities[v], options.maxEditDistance, true, actual);
+                shardedNs += timer.Nanoseconds();
+
+                string want = Describe(expected, verbosities[v]), got = Describe(actual, verbosities[v]);
+                if (want != got)
+                {
+                    if (mismatches < 5) cerr << VerbosityName(verbosities[v]) << " " << queries[q] << ": expected " << want << "got " << got << endl;
+                    ++mismatches;
+                }
+            }
+            totalMismatches += mismatches;
+            size_t n = max((size_t)1, queries.size());
+            json.BeginObject().Value("typo_edits", edits).Value("verbosity", VerbosityName(verbosities[v])).Value("mismatches", mismatches)
+                .Value("single_mean_us", singleNs / n / 1000).Value("sharded_mean_us", shardedNs / n / 1000).EndObject();
+        }
+    }
+    json.EndArray();
+    json.Value("mismatches", totalMismatches);
+    json.EndObject();
+    cout << json.str() << endl;
+    return totalMismatches == 0 ? 0 : 2;
+}